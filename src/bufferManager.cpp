@@ -2,11 +2,71 @@
 
 BufferManager::BufferManager() {
     logger.log("BufferManager::BufferManager");
+    this->policy = makeReplacementPolicy(REPLACEMENT_STRATEGY);
+}
+
+BufferManager::~BufferManager() {
+    delete this->policy;
+}
+
+/**
+ * @brief Switches the page replacement policy. Pages already in the pool are
+ * handed over to the new policy as if they had just been read in.
+ *
+ * @param strategy 
+ */
+void BufferManager::setReplacementStrategy(ReplacementStrategy strategy) {
+    logger.log("BufferManager::setReplacementStrategy");
+    lock_guard<recursive_mutex> guard(this->lock);
+    delete this->policy;
+    this->policy = makeReplacementPolicy(strategy);
+    for (auto& entry : this->frameDirectory)
+        if (!this->frames[entry.second].ring)
+            this->policy->insert(entry.second, entry.first);
+}
+
+/**
+ * @brief Turns the background writing of evicted dirty pages on or off. When
+ * turned off, pages already queued are written out first.
+ *
+ * @param enabled 
+ */
+void BufferManager::setWriteBack(bool enabled) {
+    logger.log("BufferManager::setWriteBack");
+    lock_guard<recursive_mutex> guard(this->lock);
+    if (enabled)
+        this->writer.start(BLOCK_COUNT);
+    else
+        this->writer.stop();
+}
+
+/**
+ * @brief Sets how many pages are read ahead of sequential scans. 0 turns
+ * read-ahead off.
+ *
+ * @param pages 
+ */
+void BufferManager::setReadAhead(uint pages) {
+    logger.log("BufferManager::setReadAhead");
+    lock_guard<recursive_mutex> guard(this->lock);
+    this->readAhead.setDepth(pages);
+}
+
+/**
+ * @brief Waits for all pages evicted so far to reach the disk.
+ *
+ */
+void BufferManager::flushWrites() {
+    logger.log("BufferManager::flushWrites");
+    lock_guard<recursive_mutex> guard(this->lock);
+    this->writer.barrier();
 }
 
 /**
  * @brief Function called to read a page from the buffer manager. If the page is
  * not present in the pool, the page is read and then inserted into the pool.
+ * Returns a copy of the page; use pinTablePage to read the pooled page in
+ * place.
  *
  * @param tableName 
  * @param pageIndex 
@@ -14,11 +74,41 @@ BufferManager::BufferManager() {
  */
 TablePage BufferManager::getTablePage(string tableName, int pageIndex) {
     logger.log("BufferManager::getTablePage");
-    string pageName = TABLE_PAGE_NAME(tableName, pageIndex);
-    if (this->inPool(pageName))
-        return get<TablePage>(this->getFromPool(pageName));
-    else
-        return this->insertTablePageIntoPool(tableName, pageIndex);
+    return *this->pinTablePage(tableName, pageIndex);
+}
+
+/**
+ * @brief Function called to pin a page in the buffer manager. If the page is
+ * not present in the pool, the page is read and then inserted into the pool.
+ * The page stays in the pool, unevictable, until the returned handle is
+ * released.
+ *
+ * @param tableName 
+ * @param pageIndex 
+ * @param ring if given, a miss is loaded into one of the ring's frames
+ * @return PageGuard<TablePage> 
+ */
+PageGuard<TablePage> BufferManager::pinTablePage(const string& tableName, int pageIndex, BufferRing* ring) {
+    return this->pinTablePage(PageId(getRelationId(tableName), TABLE_PAGE, pageIndex), ring);
+}
+
+/**
+ * @brief Pins the table page identified by id. Callers reading many pages of a
+ * table can keep the relation id and skip looking the table name up.
+ *
+ * @param id 
+ * @param ring if given, a miss is loaded into one of the ring's frames
+ * @return PageGuard<TablePage> 
+ */
+PageGuard<TablePage> BufferManager::pinTablePage(const PageId& id, BufferRing* ring) {
+    logger.log("BufferManager::pinTablePage");
+    lock_guard<recursive_mutex> guard(this->lock);
+    this->readAhead.onTablePage(id, [this](const PageId& next) { return this->isCached(next); });
+    int frame = this->findFrame(id);
+    if (frame == -1)
+        frame = this->insertTablePageIntoPool(id, ring);
+    this->pin(frame);
+    return PageGuard<TablePage>(frame, &get<TablePage>(this->frames[frame].page));
 }
 
 /**
@@ -31,13 +121,31 @@ TablePage BufferManager::getTablePage(string tableName, int pageIndex) {
  */
 MatrixPage BufferManager::getMatrixPage(const string& matrixName, int rowIndex, int colIndex) {
     logger.log("BufferManager::getMatrixPage");
+    return *this->pinMatrixPage(matrixName, rowIndex, colIndex);
+}
 
-    string pageName = MATRIX_PAGE_NAME(matrixName, rowIndex, colIndex);
-    if (this->inPool(pageName)) {
-        return get<MatrixPage>(this->getFromPool(pageName));
-    } else {
-        return this->insertMatrixPageIntoPool(matrixName, rowIndex, colIndex);
-    }
+/**
+ * @brief Function called to pin a matrix page in the buffer manager. If the
+ * page is not present in the pool, the page is read and then inserted into the
+ * pool.
+ *
+ * @param matrixName 
+ * @param rowIndex 
+ * @param colIndex 
+ * @return PageGuard<MatrixPage> 
+ */
+PageGuard<MatrixPage> BufferManager::pinMatrixPage(const string& matrixName, int rowIndex, int colIndex) {
+    return this->pinMatrixPage(PageId(getRelationId(matrixName), MATRIX_PAGE, rowIndex, colIndex));
+}
+
+PageGuard<MatrixPage> BufferManager::pinMatrixPage(const PageId& id) {
+    logger.log("BufferManager::pinMatrixPage");
+    lock_guard<recursive_mutex> guard(this->lock);
+    int frame = this->findFrame(id);
+    if (frame == -1)
+        frame = this->insertMatrixPageIntoPool(id);
+    this->pin(frame);
+    return PageGuard<MatrixPage>(frame, &get<MatrixPage>(this->frames[frame].page));
 }
 
 /**
@@ -50,115 +158,192 @@ MatrixPage BufferManager::getMatrixPage(const string& matrixName, int rowIndex,
  */
 HashPage BufferManager::getHashPage(const string& tableName, int bucket, int chainCount) {
     logger.log("BufferManager::getHashPage");
+    return *this->pinHashPage(tableName, bucket, chainCount);
+}
 
-    string pageName = HASH_PAGE_NAME(tableName, bucket, chainCount);
-    if (this->inPool(pageName)) {
-        return get<HashPage>(this->getFromPool(pageName));
-    } else {
-        return this->insertHashPageIntoPool(tableName, bucket, chainCount);
-    }
+/**
+ * @brief Function called to pin a linear hash page in the buffer manager. If
+ * the page is not present in the pool, the page is read and then inserted into
+ * the pool.
+ *
+ * @param tableName 
+ * @param bucket 
+ * @param chainCount 
+ * @param ring if given, a miss is loaded into one of the ring's frames
+ * @return PageGuard<HashPage> 
+ */
+PageGuard<HashPage> BufferManager::pinHashPage(const string& tableName, int bucket, int chainCount, BufferRing* ring) {
+    return this->pinHashPage(PageId(getRelationId(tableName), HASH_PAGE, bucket, chainCount), ring);
+}
+
+PageGuard<HashPage> BufferManager::pinHashPage(const PageId& id, BufferRing* ring) {
+    logger.log("BufferManager::pinHashPage");
+    lock_guard<recursive_mutex> guard(this->lock);
+    this->readAhead.onHashPage(id, [this](const PageId& next) { return this->isCached(next); });
+    int frame = this->findFrame(id);
+    if (frame == -1)
+        frame = this->insertHashPageIntoPool(id, ring);
+    this->pin(frame);
+    return PageGuard<HashPage>(frame, &get<HashPage>(this->frames[frame].page));
 }
 
 /**
- * @brief Checks to see if a page exists in the pool
+ * @brief Looks up the frame holding a page and reports the hit to the
+ * replacement policy.
  *
- * @param pageName 
- * @return true 
- * @return false 
+ * @param id 
+ * @return int frame, or -1 if the page is not in the pool
  */
-bool BufferManager::inPool(string pageName) {
-    logger.log("BufferManager::inPool");
-    for (auto page : this->pages) {
-        if (pageName == getPageName(page))
-            return true;
-    }
-    return false;
+int BufferManager::findFrame(const PageId& id) {
+    logger.log("BufferManager::findFrame");
+    auto it = this->frameDirectory.find(id);
+    if (it == this->frameDirectory.end())
+        return -1;
+    if (!this->frames[it->second].ring)
+        this->policy->access(it->second);
+    return it->second;
 }
 
 /**
- * @brief If the page is present in the pool, then this function returns the
- * page. Note that this function will fail if the page is not present in the
- * pool.
+ * @brief Checks if a page is in the pool, without counting it as a hit.
  *
- * @param pageName 
- * @return TablePage 
+ * @param id 
+ * @return true if the page is in the pool
  */
-Pages BufferManager::getFromPool(string pageName) {
-    logger.log("BufferManager::getFromPool");
-    for (auto page : this->pages)
-        if (pageName == getPageName(page))
-            return page;
+bool BufferManager::isCached(const PageId& id) {
+    return this->frameDirectory.count(id);
 }
 
 /**
- * @brief Inserts page indicated by tableName and pageIndex into pool. If the
- * pool is full, the pool ejects the oldest inserted page from the pool and adds
- * the current page at the end. It naturally follows a queue data structure. 
+ * @brief Returns a free frame slot, growing the frame table if none of the
+ * previously released slots can be reused.
  *
- * @param tableName 
- * @param pageIndex 
- * @return TablePage 
+ * @return int 
  */
-TablePage BufferManager::insertTablePageIntoPool(string tableName, int pageIndex) {
-    logger.log("BufferManager::insertIntoPool");
-    TablePage page(tableName, pageIndex);
+int BufferManager::allocateFrame() {
+    if (!this->freeFrames.empty()) {
+        int frame = this->freeFrames.back();
+        this->freeFrames.pop_back();
+        return frame;
+    }
+    this->frames.emplace_back();
+    return this->frames.size() - 1;
+}
+
+/**
+ * @brief Removes the page held in frame from the directory and the replacement
+ * policy (or its ring), and returns the slot to the free list. A pinned frame
+ * is only detached, and is freed by the last unpin. Does not write back.
+ *
+ * @param frame 
+ */
+void BufferManager::releaseFrame(int frame) {
+    this->frameDirectory.erase(getPageId(this->frames[frame].page));
+    this->untrack(frame);
+    if (this->frames[frame].ring) {
+        this->frames[frame].ring->frames.remove(frame);
+        this->frames[frame].ring = nullptr;
+    } else {
+        this->policy->erase(frame);
+        this->sharedFrameCount--;
+    }
+    if (this->frames[frame].pinCount) {
+        this->frames[frame].detached = true;
+        return;
+    }
+    this->frames[frame] = Frame();
+    this->freeFrames.push_back(frame);
+}
 
+void BufferManager::pin(int frame) {
+    lock_guard<recursive_mutex> guard(this->lock);
+    this->frames[frame].pinCount++;
+}
+
+/**
+ * @brief Releases one pin on frame. If the page was changed through the pin,
+ * it is treated like a page passed to write*Page: written right away unless
+ * writes are deferred, in which case the frame is marked dirty. Detached
+ * frames are freed once they are unpinned.
+ *
+ * @param frame 
+ * @param modified 
+ */
+void BufferManager::unpin(int frame, bool modified) {
+    logger.log("BufferManager::unpin");
+    lock_guard<recursive_mutex> guard(this->lock);
+    Frame& pinned = this->frames[frame];
+    if (modified && !pinned.detached) {
 #ifdef DEFER_WRITE
-    this->push(page);
+        pinned.dirty = true;
 #else
-    this->push(page, false);
+        writePage(pinned.page);
 #endif
+        this->updateZoneMap(pinned.page);
+        // the page may have grown or shrunk
+        this->untrack(frame);
+        this->track(frame);
+    }
+    pinned.pinCount--;
+    if (!pinned.pinCount && pinned.detached) {
+        pinned = Frame();
+        this->freeFrames.push_back(frame);
+    }
+}
+
+/**
+ * @brief Inserts the table page indicated by id into pool. If the pool is
+ * full, the replacement policy picks an unpinned page to eject from the pool.
+ *
+ * @param id 
+ * @param ring 
+ * @return int frame holding the page
+ */
+int BufferManager::insertTablePageIntoPool(const PageId& id, BufferRing* ring) {
+    logger.log("BufferManager::insertIntoPool");
+    Pages page;
+    if (!this->writer.lookup(id, page))
+        page = TablePage(id);
 
-    return page;
+    return this->push(page, false, ring);
 }
 
 /**
- * @brief Inserts linear hashed page indicated by tableName, bucket and chainCount into pool.
- * If the pool is full, the pool ejects the oldest inserted page from the pool and adds
- * the current page at the end. It naturally follows a queue data structure. 
+ * @brief Inserts the linear hashed page indicated by id (bucket, chainCount)
+ * into pool. If the pool is full, the replacement policy picks an unpinned
+ * page to eject from the pool.
  *
- * @param tableName 
- * @param bucket
- * @param chainCount
+ * @param id 
+ * @param ring 
  *  
- * @return TablePage 
+ * @return int frame holding the page
  */
-HashPage BufferManager::insertHashPageIntoPool(const string& tableName, int bucket, int chainCount) {
+int BufferManager::insertHashPageIntoPool(const PageId& id, BufferRing* ring) {
     logger.log("BufferManager::insertHashPageIntoPool");
-    HashPage page(tableName, bucket, chainCount);
-
-#ifdef DEFER_WRITE
-    this->push(page);
-#else
-    this->push(page, false);
-#endif
+    Pages page;
+    if (!this->writer.lookup(id, page))
+        page = HashPage(id);
 
-    return page;
+    return this->push(page, false, ring);
 }
 
 /**
- * @brief Inserts linear hashed page indicated by matrixName, rowIndex and colIndex into pool.
- * If the pool is full, the pool ejects the oldest inserted page from the pool and adds
- * the current page at the end. It naturally follows a queue data structure. 
+ * @brief Inserts the matrix page indicated by id (rowIndex, colIndex) into
+ * pool. If the pool is full, the replacement policy picks an unpinned page to
+ * eject from the pool.
  *
- * @param matrixName
- * @param rowIndex
- * @param colIndex
+ * @param id 
  *  
- * @return TablePage 
+ * @return int frame holding the page
  */
-MatrixPage BufferManager::insertMatrixPageIntoPool(const string& matrixName, int rowIndex, int colIndex) {
+int BufferManager::insertMatrixPageIntoPool(const PageId& id) {
     logger.log("BufferManager::insertMatrixPageIntoPool");
 
-    MatrixPage page(matrixName, rowIndex, colIndex);
-
-#ifdef DEFER_WRITE
-    this->push(page);
-#else
-    this->push(page, false);
-#endif
+    Pages page;
+    if (!this->writer.lookup(id, page))
+        page = MatrixPage(getRelationName(id.relation), id.x, id.y);
 
-    return page;
+    return this->push(page, false);
 }
 
 /**
@@ -172,36 +357,27 @@ MatrixPage BufferManager::insertMatrixPageIntoPool(const string& matrixName, int
  */
 void BufferManager::writeTablePage(string tableName, int pageIndex, vector<vector<int>> rows, int rowCount) {
     logger.log("BufferManager::writeTablePage");
+    lock_guard<recursive_mutex> guard(this->lock);
     TablePage page(tableName, pageIndex, rows, rowCount);
 
-#ifdef DEFER_WRITE
-    this->push(page);
-#else
-    this->push(page, false);
-#endif
+    this->pushWritten(page);
 }
 
 void BufferManager::writeHashPage(const string& tableName, int bucket, int chainCount, const vector<vector<int>>& data) {
+    lock_guard<recursive_mutex> guard(this->lock);
     // cout << "DEBUGPAGESIZE" << data.size() << endl; // TODO: check for correctness
     logger.log("BufferManager::writeHashPage");
     HashPage page(tableName, bucket, chainCount, data);
 
-#ifdef DEFER_WRITE
-    this->push(page);
-#else
-    this->push(page, false);
-#endif
+    this->pushWritten(page);
 }
 
 void BufferManager::writeMatrixPage(const string& matrixName, int rowIndex, int colIndex, const vector<vector<int>>& data) {
     logger.log("BufferManager::writeMatrixPage");
+    lock_guard<recursive_mutex> guard(this->lock);
     MatrixPage page(matrixName, rowIndex, colIndex, data);
 
-#ifdef DEFER_WRITE
-    this->push(page);
-#else
-    this->push(page, false);
-#endif
+    this->pushWritten(page);
 }
 
 /**
@@ -210,28 +386,65 @@ void BufferManager::writeMatrixPage(const string& matrixName, int rowIndex, int
  * @param fileName 
  */
 void BufferManager::deleteFile(string fileName) {
+    lock_guard<recursive_mutex> guard(this->lock);
     if (remove(fileName.c_str()))
-        logger.log("BufferManager::deleteFile: Err");
+        logger.debug("BufferManager::deleteFile: Err");
     else
         logger.log("BufferManager::deleteFile: Success");
 }
 
 /**
- * @brief Overloaded function that calls deleteFile(fileName) by constructing
- * the fileName from the tableName and pageIndex.
+ * @brief Deletes page id from the pool, the write-back queue and its segment.
+ * No file is touched: its extent is reused by later pages of the segment.
+ *
+ * @param id 
+ */
+void BufferManager::deletePage(const PageId& id) {
+    lock_guard<recursive_mutex> guard(this->lock);
+    this->pop(id);
+    this->zoneMaps.erase(id);
+    this->writer.cancel([&](const PageId& queued) { return queued == id; });
+    segmentStore.erase(id);
+}
+
+/**
+ * @brief Deletes all pages of kind of relationName at once, dropping the
+ * segment file that holds them.
+ *
+ * @param relationName 
+ * @param kind 
+ */
+void BufferManager::deleteSegment(const string& relationName, PageKind kind) {
+    logger.log("BufferManager::deleteSegment");
+    lock_guard<recursive_mutex> guard(this->lock);
+    PageId segment = PageId(getRelationId(relationName), kind, -1, -1);
+    vector<int> segmentFrames;
+    for (auto& entry : this->frameDirectory)
+        if (entry.first.segment() == segment)
+            segmentFrames.push_back(entry.second);
+    for (int frame : segmentFrames)
+        this->releaseFrame(frame);
+    erase_if(this->zoneMaps, [&](const auto& entry) { return entry.first.segment() == segment; });
+    this->writer.cancel([&](const PageId& queued) { return queued.segment() == segment; });
+    segmentStore.drop(segment);
+}
+
+/**
+ * @brief Overloaded function that calls deletePage(id) by constructing the id
+ * from the tableName and pageIndex.
  *
  * @param tableName 
  * @param pageIndex 
  */
 void BufferManager::deleteTableFile(string tableName, int pageIndex) {
     logger.log("BufferManager::deleteTableFile");
-    string fileName = TABLE_PAGE_NAME(tableName, pageIndex);
-    this->pop(fileName);
-    this->deleteFile(fileName);
+    lock_guard<recursive_mutex> guard(this->lock);
+    PageId id(getRelationId(tableName), TABLE_PAGE, pageIndex);
+    this->deletePage(id);
 }
 /**
- * @brief Overloaded function that calls deleteFile(fileName) by constructing
- * the fileName from the matrixName and rowIndex and colIndex.
+ * @brief Overloaded function that calls deletePage(id) by constructing the id
+ * from the matrixName and rowIndex and colIndex.
  *
  * @param matrixName 
  * @param rowIndex 
@@ -239,14 +452,14 @@ void BufferManager::deleteTableFile(string tableName, int pageIndex) {
  */
 void BufferManager::deleteMatrixFile(const string& matrixName, int rowIndex, int colIndex) {
     logger.log("BufferManager::deleteMatrixFile");
+    lock_guard<recursive_mutex> guard(this->lock);
 
-    string fileName = MATRIX_PAGE_NAME(matrixName, rowIndex, colIndex);
-    this->pop(fileName);
-    this->deleteFile(fileName);
+    PageId id(getRelationId(matrixName), MATRIX_PAGE, rowIndex, colIndex);
+    this->deletePage(id);
 }
 /**
- * @brief Overloaded function that calls deleteFile(fileName) by constructing
- * the fileName from the tableName and bucket and chainCount.
+ * @brief Overloaded function that calls deletePage(id) by constructing the id
+ * from the tableName and bucket and chainCount.
  *
  * @param tableName 
  * @param bucket
@@ -254,54 +467,348 @@ void BufferManager::deleteMatrixFile(const string& matrixName, int rowIndex, int
  */
 void BufferManager::deleteHashFile(const string& tableName, int bucket, int chainCount) {
     logger.log("BufferManager::deleteHashFile");
+    lock_guard<recursive_mutex> guard(this->lock);
 
-    string fileName = HASH_PAGE_NAME(tableName, bucket, chainCount);
-    this->pop(fileName);
-    this->deleteFile(fileName);
+    PageId id(getRelationId(tableName), HASH_PAGE, bucket, chainCount);
+    this->deletePage(id);
 }
 /**
- * @brief Pushes the page into bufferManager
+ * @brief Pushes a page that was written by an executor. Unless writes are
+ * deferred, the page is written to disk right away and enters the pool clean.
  *
  * @param page 
- * @param deferWrite 
+ * @return int frame holding the page
  */
-void BufferManager::push(Pages page, bool deferWrite) {
-    if (!deferWrite) {
-        writePage(page);  // write current page instantly if not deferred
-    }
+int BufferManager::pushWritten(Pages page) {
+    this->updateZoneMap(page);
+#ifdef DEFER_WRITE
+    return this->push(page, true);
+#else
+    writePage(page);
+    return this->push(page, false);
+#endif
+}
+
+/**
+ * @brief Records the zone map of a table or hash page that was just written.
+ *
+ * @param page 
+ */
+void BufferManager::updateZoneMap(const Pages& page) {
+    PageId id = getPageId(page);
+    if (id.kind == MATRIX_PAGE)
+        return;
+    this->zoneMaps[id] = visit([](auto&& arg) { return arg.getZoneMap(); }, page);
+}
+
+/**
+ * @brief Zone map of page id, if the page was written since the server started.
+ *
+ * @param id 
+ * @return const ZoneMap* nullptr if the zone map of the page is not known
+ */
+const ZoneMap* BufferManager::getZoneMap(const PageId& id) {
+    lock_guard<recursive_mutex> guard(this->lock);
+    auto it = this->zoneMaps.find(id);
+    return it == this->zoneMaps.end() ? nullptr : &it->second;
+}
+
+/**
+ * @brief Writes the page held in frame to disk, or queues it for the
+ * background writer if write-back is on.
+ *
+ * @param frame 
+ */
+void BufferManager::writeBack(int frame) {
+    if (this->writer.isRunning())
+        this->writer.enqueue(this->frames[frame].page);
+    else
+        writePage(this->frames[frame].page);
+}
 
+/**
+ * @brief Pushes the page into bufferManager. If an older version of the page
+ * is pinned, the older version is detached and stays with its readers.
+ *
+ * @param page 
+ * @param dirty true if the page differs from its file on disk
+ * @param ring if given and active, the page is loaded into one of its frames
+ * instead of the shared pool
+ * @return int frame holding the page
+ */
+int BufferManager::push(Pages page, bool dirty, BufferRing* ring) {
     // already in buffer
-    for (auto &p : this->pages) {
-        if (getPageName(p) == getPageName(page)) {
-            p = page;
-            return;
+    PageId id = getPageId(page);
+    auto it = this->frameDirectory.find(id);
+    if (it != this->frameDirectory.end()) {
+        int frame = it->second;
+        if (!this->frames[frame].pinCount) {
+            this->untrack(frame);
+            this->frames[frame].page = move(page);
+            this->frames[frame].dirty = dirty;
+            this->track(frame);
+            if (!this->frames[frame].ring)
+                this->policy->access(frame);
+            return frame;
         }
+        this->releaseFrame(frame);
     }
 
-    // kick first page out of buffer
-    if (this->pages.size() >= BLOCK_COUNT && !this->pages.empty()) { // so it runs even if block count is set to 0
-        if (deferWrite) {
-            writePage(this->pages.front()); // wasn't written earlier, because deferred
-        }
-        this->pages.pop_front();
+    int frame;
+    if (ring && ring->active) {
+        this->recycle(ring);
+        frame = this->allocateFrame();
+        this->frames[frame].ring = ring;
+        ring->frames.push_back(frame);
+    } else {
+        this->makeRoom(1, getPageFootprint(page), id.relation);
+        frame = this->allocateFrame();
+        this->policy->insert(frame, id);
+        this->sharedFrameCount++;
     }
 
     // insert this page
-    this->pages.emplace_back(page);
+    this->frames[frame].page = move(page);
+    this->frames[frame].dirty = dirty;
+    this->frameDirectory[id] = frame;
+    this->track(frame);
+    return frame;
+}
+
+/**
+ * @brief Kicks pages out of the shared pool, as chosen by the replacement
+ * policy, until frameCount more frames holding bytes more bytes of relation
+ * fit: first within the relation's quota, if it has one, then within the byte
+ * budget, or BLOCK_COUNT frames if there is no budget. If every candidate is
+ * pinned, the pool grows past its limit until pins are released.
+ *
+ * @param frameCount 
+ * @param bytes 
+ * @param relation 
+ */
+void BufferManager::makeRoom(uint frameCount, size_t bytes, int relation) {
+    auto quota = this->quotas.find(relation);
+    if (quota != this->quotas.end()) {
+        auto unpinnedOfRelation = [&](int frame) {
+            return !this->frames[frame].pinCount && this->frames[frame].relation == relation;
+        };
+        while (this->relationBytes[relation] + bytes > quota->second) {
+            int victim = this->policy->victim(unpinnedOfRelation);
+            if (victim == -1)
+                break;
+            this->evict(victim);
+        }
+    }
+
+    auto unpinned = [&](int frame) { return !this->frames[frame].pinCount; };
+    while (this->byteBudget ? this->poolBytes + bytes > this->byteBudget
+                            : this->sharedFrameCount + frameCount > BLOCK_COUNT) {
+        int victim = this->policy->victim(unpinned);
+        if (victim == -1)
+            break;
+        this->evict(victim);
+    }
+}
+
+/**
+ * @brief Drops the page held in frame from the pool, writing it back first if
+ * it is dirty.
+ *
+ * @param frame 
+ */
+void BufferManager::evict(int frame) {
+    if (this->frames[frame].dirty)
+        this->writeBack(frame); // wasn't written earlier, because deferred
+    this->releaseFrame(frame);
+}
+
+/**
+ * @brief Adds the footprint of the page in frame to the memory accounted to
+ * the pool and to its relation.
+ *
+ * @param frame 
+ */
+void BufferManager::track(int frame) {
+    Frame& tracked = this->frames[frame];
+    tracked.relation = getPageId(tracked.page).relation;
+    tracked.bytes = getPageFootprint(tracked.page);
+    this->poolBytes += tracked.bytes;
+    this->relationBytes[tracked.relation] += tracked.bytes;
+}
+
+void BufferManager::untrack(int frame) {
+    Frame& tracked = this->frames[frame];
+    this->poolBytes -= tracked.bytes;
+    this->relationBytes[tracked.relation] -= tracked.bytes;
+    tracked.bytes = 0;
+}
+
+/**
+ * @brief Bounds the pool by the memory its pages take rather than by
+ * BLOCK_COUNT. 0 goes back to BLOCK_COUNT frames.
+ *
+ * @param bytes 
+ */
+void BufferManager::setByteBudget(size_t bytes) {
+    logger.log("BufferManager::setByteBudget");
+    lock_guard<recursive_mutex> guard(this->lock);
+    this->byteBudget = bytes;
+    this->makeRoom(0, 0, -1);
+}
+
+/**
+ * @brief Limits the memory the pages of relation may take in the pool. 0
+ * removes the quota.
+ *
+ * @param relation 
+ * @param bytes 
+ */
+void BufferManager::setQuota(const string& relation, size_t bytes) {
+    logger.log("BufferManager::setQuota");
+    lock_guard<recursive_mutex> guard(this->lock);
+    int relationId = getRelationId(relation);
+    if (bytes)
+        this->quotas[relationId] = bytes;
+    else
+        this->quotas.erase(relationId);
+    this->makeRoom(0, 0, relationId);
+}
+
+/**
+ * @brief Turns memory mapped access to the pages of tableName on or off. When
+ * turned on, clean pages of the table are dropped from the pool, as cursors
+ * will view them in the mapping instead.
+ *
+ * @param tableName 
+ * @param mapped 
+ */
+void BufferManager::setMapped(const string& tableName, bool mapped) {
+    logger.log("BufferManager::setMapped");
+    lock_guard<recursive_mutex> guard(this->lock);
+    int relation = getRelationId(tableName);
+    if (!mapped) {
+        this->mappedRelations.erase(relation);
+        segmentStore.unmap(PageId(relation, TABLE_PAGE, -1, -1));
+        segmentStore.unmap(PageId(relation, HASH_PAGE, -1, -1));
+        return;
+    }
+    this->mappedRelations.insert(relation);
+    vector<int> cleanFrames;
+    for (auto& entry : this->frameDirectory) {
+        Frame& frame = this->frames[entry.second];
+        if (entry.first.relation == relation && !frame.dirty && !frame.pinCount && !frame.ring)
+            cleanFrames.push_back(entry.second);
+    }
+    for (int frame : cleanFrames)
+        this->releaseFrame(frame);
+}
+
+/**
+ * @brief Drops the settings kept for relationName when the relation is
+ * dropped. Relation ids are never reused, so otherwise a relation loaded
+ * later under the same name would silently inherit them.
+ *
+ * @param relationName
+ */
+void BufferManager::forgetRelation(const string& relationName) {
+    logger.log("BufferManager::forgetRelation");
+    lock_guard<recursive_mutex> guard(this->lock);
+    int relation = getRelationId(relationName);
+    this->quotas.erase(relation);
+    this->relationBytes.erase(relation);
+    if (this->mappedRelations.erase(relation)) {
+        segmentStore.unmap(PageId(relation, TABLE_PAGE, -1, -1));
+        segmentStore.unmap(PageId(relation, HASH_PAGE, -1, -1));
+    }
+}
+
+/**
+ * @brief Views page id in the mapping of its segment, if its table is mapped.
+ * Pages in the pool or waiting for the background writer are newer than the
+ * mapping, so they are not viewed and have to be pinned as usual.
+ *
+ * @param id 
+ * @return PageView empty if the page cannot be viewed
+ */
+PageView BufferManager::viewPage(const PageId& id) {
+    lock_guard<recursive_mutex> guard(this->lock);
+    if (!this->mappedRelations.count(id.relation) || this->frameDirectory.count(id) || this->writer.isPending(id))
+        return PageView();
+    size_t length = 0;
+    const char* bytes = segmentStore.map(id, length);
+    return PageView(bytes, length);
+}
+
+/**
+ * @brief Passes madvise advice for page id, or its whole segment, on to the
+ * mapping if its table is mapped.
+ *
+ * @param id 
+ * @param advice 
+ */
+void BufferManager::adviseMapped(const PageId& id, int advice) {
+    lock_guard<recursive_mutex> guard(this->lock);
+    if (this->mappedRelations.count(id.relation))
+        segmentStore.advise(id, advice);
+}
+
+/**
+ * @brief Makes room in a full ring by dropping its oldest unpinned frame. If
+ * every frame of the ring is pinned, the ring grows instead.
+ *
+ * @param ring 
+ */
+void BufferManager::recycle(BufferRing* ring) {
+    if (ring->frames.size() < ring->size)
+        return;
+    for (int frame : ring->frames) {
+        if (this->frames[frame].pinCount)
+            continue;
+        this->evict(frame);
+        return;
+    }
+}
+
+/**
+ * @brief Called when a ring goes out of scope. Its unpinned frames are
+ * dropped; frames still pinned are handed over to the shared pool.
+ *
+ * @param ring 
+ */
+void BufferManager::releaseRing(BufferRing* ring) {
+    logger.log("BufferManager::releaseRing");
+    lock_guard<recursive_mutex> guard(this->lock);
+    while (!ring->frames.empty()) {
+        int frame = ring->frames.front();
+        if (this->frames[frame].pinCount) {
+            ring->frames.pop_front();
+            this->frames[frame].ring = nullptr;
+            this->policy->insert(frame, getPageId(this->frames[frame].page));
+            this->sharedFrameCount++;
+            continue;
+        }
+        this->evict(frame);
+    }
+}
+
+BufferRing::BufferRing(uint pageCount) {
+    this->size = BUFFER_RING_SIZE;
+    this->active = pageCount > BLOCK_COUNT / 4;
+}
+
+BufferRing::~BufferRing() {
+    bufferManager.releaseRing(this);
 }
 /**
  * @brief Pops the page from bufferManager
  *
- * @param page 
- * @param deferWrite 
+ * @param id 
  */
-void BufferManager::pop(const string& fileName) {
+void BufferManager::pop(const PageId& id) {
+    lock_guard<recursive_mutex> guard(this->lock);
     // DOES NOT WRITEBACK
     
-    for (int i = 0; i < this->pages.size(); i++) {
-        if (getPageName(this->pages[i]) == fileName) {
-            this->pages.erase(this->pages.begin() + i);
-            return;
-        }
-    }
-}
\ No newline at end of file
+    auto it = this->frameDirectory.find(id);
+    if (it != this->frameDirectory.end())
+        this->releaseFrame(it->second);
+}
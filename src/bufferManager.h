@@ -3,63 +3,320 @@
 
 #include "page.h"
 #include "bPlusTree.h"
+#include "replacementPolicy.h"
+#include "pageWriter.h"
+#include "readAhead.h"
+#include "segmentStore.h"
+
+#ifndef BUFFER_BYTES
+#define BUFFER_BYTES 0
+#endif
+
+#ifndef BUFFER_RING_SIZE
+#define BUFFER_RING_SIZE 2
+#endif
 /**
  * @brief The BufferManager is responsible for reading pages to the main memory.
  * Recall that large files are broken and stored as blocks in the hard disk. The
  * minimum amount of memory that can be read from the disk is a block whose size
- * is indicated by BLOCK_SIZE. within this system we simulate blocks by
- * splitting and storing the file as multiple files each of one BLOCK_SIZE,
- * although this isn't traditionally how it's done. You can alternatively just
- * random access to the point where a block begins within the same
- * file. In this system we assume that the the sizes of blocks and pages are the
- * same. 
+ * is indicated by BLOCK_SIZE. Within this system the blocks of a relation are
+ * stored at fixed offsets of a single segment file and read with random
+ * access to the point where a block begins (see SegmentStore). In this system
+ * we assume that the the sizes of blocks and pages are the same. 
  * 
  * <p>
  * The buffer can hold multiple pages quantified by BLOCK_COUNT. The
- * buffer manager follows the FIFO replacement policy i.e. the first block to be
- * read in is replaced by the new incoming block. This replacement policy should
- * be transparent to the executors i.e. the executor should not know if a block
- * was previously present in the buffer or was read in from the disk. 
+ * buffer manager follows the FIFO replacement policy by default i.e. the first
+ * block to be read in is replaced by the new incoming block. LRU, CLOCK and 2Q
+ * can be chosen instead, either at compile time or using the SET BUFFER_POLICY
+ * command. This replacement policy should be transparent to the executors i.e.
+ * the executor should not know if a block was previously present in the buffer
+ * or was read in from the disk. 
+ * </p>
+ *
+ * <p>
+ * Pages are held in frame slots. A frame directory maps each page id to the
+ * slot holding it, so checking the pool for a page takes constant time
+ * irrespective of BLOCK_COUNT. File names are only built on a miss.
+ * </p>
+ *
+ * <p>
+ * With write-back turned on (SET WRITE_BACK ON), dirty pages evicted from the
+ * pool are handed to a PageWriter and written on a background thread.
+ * Sequential table scans and bucket walks are detected by ReadAhead, which
+ * gets the kernel to read the next page files in early.
+ * </p>
+ *
+ * <p>
+ * The pool can be bounded by the memory its pages take instead (SET
+ * BUFFER_BYTES), and a relation can be limited to a quota of that memory (SET
+ * QUOTA), in which case its own pages are evicted first when it exceeds it.
+ * </p>
+ *
+ * <p>
+ * Operators scanning a large table can read it through a BufferRing, so that
+ * the scan recycles a few private frames instead of flushing the pool.
+ * </p>
+ *
+ * <p>
+ * The segments of read-mostly tables can be memory mapped (SET MMAP). Cursors
+ * over such a table view its pages in the mapping rather than reading them
+ * into the pool, which then only holds the pages of the table that were
+ * modified and not yet written back.
  * </p>
  *
+ * <p>
+ * Every table page and hash page written, either through write*Page or by
+ * changing a pinned page, has its ZoneMap recorded, which cursors consult to
+ * skip pages that cannot satisfy their filter.
+ * </p>
+ *
+ * <p>
+ * All public calls are serialised, so that the worker threads of a
+ * ParallelScan can pin and release pages at the same time. A pinned page is
+ * read without holding the lock.
+ * </p>
+ *
+ */
+/**
+ * @brief A frame of the buffer pool. Each frame records the memory its page
+ * takes, which is charged to the page's relation. Frames loaded through a
+ * BufferRing belong to the ring and are not managed by the replacement policy.
+ * A frame is dirty if its page was written while writes are deferred, and only
+ * dirty frames are written back when they are evicted. A frame that is pinned
+ * cannot be evicted. If the page it holds is deleted or overwritten while it
+ * is pinned, the frame is detached from the pool instead, and is only freed
+ * once the last pin on it is released, so that readers keep seeing the page
+ * they pinned.
+ *
+ */
+class BufferRing;
+
+struct Frame {
+    Pages page;
+    BufferRing* ring = nullptr;
+    int relation = -1;
+    size_t bytes = 0;
+    int pinCount = 0;
+    bool dirty = false;
+    bool detached = false;
+};
+
+/**
+ * @brief A pinned handle on a page held in the buffer pool. The handle gives
+ * access to the pooled page without copying it, and keeps the frame pinned
+ * for as long as it (or a copy of it) is alive. Changes made through mutate()
+ * are handed back to the buffer manager when the handle is released, exactly
+ * as if the page had been written through write*Page.
+ *
+ * @tparam T TablePage, HashPage, MatrixPage, or Page to read either of the
+ * first two
  */
+template <typename T>
+class PageGuard {
+    template <typename U>
+    friend class PageGuard;
+
+    int frame = -1;
+    T* page = nullptr;
+    bool modified = false;
+
+   public:
+    PageGuard() {}
+    PageGuard(int frame, T* page);
+    PageGuard(const PageGuard& other);
+    PageGuard(PageGuard&& other);
+    template <typename U>
+    PageGuard(PageGuard<U>&& other);
+    PageGuard& operator=(PageGuard other);
+    ~PageGuard();
+
+    const T& operator*() const { return *this->page; }
+    const T* operator->() const { return this->page; }
+    explicit operator bool() const { return this->page != nullptr; }
+    T& mutate();
+    void release();
+};
+
+/**
+ * @brief A private ring of frames for one scan over a large table. Pages the
+ * scan finds in the pool are shared as usual, but pages it has to read are
+ * loaded into the ring's own frames, which are recycled oldest first once the
+ * ring is full. A scan over a table that fits in a quarter of the pool does
+ * not use the ring. The ring gives its frames back when it goes out of scope,
+ * so it must outlive the cursors using it.
+ *
+ */
+class BufferRing {
+    friend class BufferManager;
+
+    uint size;
+    bool active;
+    list<int> frames;  // oldest first
+
+   public:
+    BufferRing(uint pageCount);
+    BufferRing(const BufferRing&) = delete;
+    BufferRing& operator=(const BufferRing&) = delete;
+    ~BufferRing();
+};
+
 class BufferManager{
-    deque<Pages> pages; 
-    bool inPool(string pageName);
-    Pages getFromPool(string pageName);
+    // taken by every public call, as the workers of a ParallelScan read pages
+    // concurrently. Recursive, as public calls nest
+    recursive_mutex lock;
+
+    // frame slots, indexed by the frameDirectory. freed slots are reused.
+    // a deque, so that pinned frames do not move as the pool grows
+    deque<Frame> frames;
+    vector<int> freeFrames;
+    unordered_map<PageId, int, PageIdHash> frameDirectory;
+    uint sharedFrameCount = 0; // frames managed by the policy, not in a ring
+
+    // memory taken by the pages in the pool, in total and per relation
+    size_t byteBudget = BUFFER_BYTES;
+    size_t poolBytes = 0;
+    unordered_map<int, size_t> relationBytes;
+    unordered_map<int, size_t> quotas;
+    unordered_set<int> mappedRelations;
+    unordered_map<PageId, ZoneMap, PageIdHash> zoneMaps;
+
+    ReplacementPolicy* policy;
+    PageWriter writer;
+    ReadAhead readAhead;
+    bool isCached(const PageId& id);
+
+    int findFrame(const PageId& id);
+    int allocateFrame();
+    void releaseFrame(int frame);
+    int push(Pages page, bool dirty, BufferRing* ring = nullptr);
+    void recycle(BufferRing* ring);
+    void makeRoom(uint frameCount, size_t bytes, int relation);
+    void evict(int frame);
+    void track(int frame);
+    void untrack(int frame);
+    int pushWritten(Pages page);
+    void updateZoneMap(const Pages& page);
+    void writeBack(int frame);
 
     // FOR TABLE
-    TablePage insertTablePageIntoPool(string tableName, int pageIndex);
+    int insertTablePageIntoPool(const PageId& id, BufferRing* ring);
 
     // FOR MATRIX
-    MatrixPage insertMatrixPageIntoPool(const string& matrixName, int rowIndex, int colIndex);
+    int insertMatrixPageIntoPool(const PageId& id);
 
     // FOR LINEAR HASHING
-    HashPage insertHashPageIntoPool(const string& tableName, int bucket, int chainCount);
+    int insertHashPageIntoPool(const PageId& id, BufferRing* ring);
 
    public:
     
     BufferManager();
+    ~BufferManager();
+    void setReplacementStrategy(ReplacementStrategy strategy);
+    void setWriteBack(bool enabled);
+    void setReadAhead(uint pages);
+    void setByteBudget(size_t bytes);
+    void setQuota(const string& relation, size_t bytes);
+    void setMapped(const string& tableName, bool mapped);
+    void forgetRelation(const string& relationName);
+    PageView viewPage(const PageId& id);
+    void adviseMapped(const PageId& id, int advice);
+    const ZoneMap* getZoneMap(const PageId& id);
+    void flushWrites();
     void deleteFile(string fileName);
-    void push(Pages page, bool deferWrite=true);
-    void pop(const string& fileName);
-    // void writeTablePage(string tableName, vector<vector<int>> rows);
-    ;
+    void deletePage(const PageId& id);
+    void deleteSegment(const string& relationName, PageKind kind);
+    void pop(const PageId& id);
+    void pin(int frame);
+    void unpin(int frame, bool modified);
+    void releaseRing(BufferRing* ring);
 
     // FOR TABLE
     TablePage getTablePage(string tableName, int pageIndex);
+    PageGuard<TablePage> pinTablePage(const string& tableName, int pageIndex, BufferRing* ring = nullptr);
+    PageGuard<TablePage> pinTablePage(const PageId& id, BufferRing* ring = nullptr);
     void deleteTableFile(string tableName, int pageIndex);
     void writeTablePage(string tableName, int pageIndex, vector<vector<int>> rows, int rowCount);
     
     // FOR MATRIX
     MatrixPage getMatrixPage(const string& matrixName, int rowIndex, int colIndex);
+    PageGuard<MatrixPage> pinMatrixPage(const string& matrixName, int rowIndex, int colIndex);
+    PageGuard<MatrixPage> pinMatrixPage(const PageId& id);
     void writeMatrixPage(const string& matrixName, int rowIndex, int colIndex, const vector<vector<int>>& data);
     void deleteMatrixFile(const string& matrixName, int rowIndex, int colIndex);
 
     // FOR LINEAR HASHING
     HashPage getHashPage(const string& tableName, int bucket, int chainCount);
+    PageGuard<HashPage> pinHashPage(const string& tableName, int bucket, int chainCount, BufferRing* ring = nullptr);
+    PageGuard<HashPage> pinHashPage(const PageId& id, BufferRing* ring = nullptr);
     void writeHashPage(const string& tableName, int bucket, int chainCount, const vector<vector<int>>& data);
     void deleteHashFile(const string& tableName, int bucket, int chainCount);
 };
 
+extern BufferManager bufferManager;
+
+template <typename T>
+PageGuard<T>::PageGuard(int frame, T* page) : frame(frame), page(page) {
+}
+
+template <typename T>
+PageGuard<T>::PageGuard(const PageGuard& other) : frame(other.frame), page(other.page) {
+    if (this->frame != -1)
+        bufferManager.pin(this->frame);
+}
+
+template <typename T>
+PageGuard<T>::PageGuard(PageGuard&& other) : frame(other.frame), page(other.page), modified(other.modified) {
+    other.frame = -1;
+    other.page = nullptr;
+    other.modified = false;
+}
+
+template <typename T>
+template <typename U>
+PageGuard<T>::PageGuard(PageGuard<U>&& other) : frame(other.frame), page(other.page), modified(other.modified) {
+    other.frame = -1;
+    other.page = nullptr;
+    other.modified = false;
+}
+
+template <typename T>
+PageGuard<T>& PageGuard<T>::operator=(PageGuard other) {
+    swap(this->frame, other.frame);
+    swap(this->page, other.page);
+    swap(this->modified, other.modified);
+    return *this;
+}
+
+template <typename T>
+PageGuard<T>::~PageGuard() {
+    this->release();
+}
+
+/**
+ * @brief Gives mutable access to the pooled page. The page is treated as
+ * written when the handle is released.
+ *
+ * @return T& 
+ */
+template <typename T>
+T& PageGuard<T>::mutate() {
+    this->modified = true;
+    return *this->page;
+}
+
+/**
+ * @brief Unpins the frame early. The handle is empty afterwards.
+ *
+ */
+template <typename T>
+void PageGuard<T>::release() {
+    if (this->frame == -1)
+        return;
+    bufferManager.unpin(this->frame, this->modified);
+    this->frame = -1;
+    this->page = nullptr;
+    this->modified = false;
+}
+
 #endif
\ No newline at end of file
@@ -1,35 +1,65 @@
 #include "global.h"
+#include <sys/mman.h>
 
 Cursor::Cursor() {
     logger.log("Cursor::Cursor");
 }
 
-Cursor::Cursor(string tableName, int pageIndex) {
+Cursor::Cursor(string tableName, int pageIndex, BufferRing* ring, PageFilter filter, int endPage) {
     logger.log("Cursor::Cursor");
-    this->page = bufferManager.getTablePage(tableName, pageIndex);
-    this->pagePointer = 0;
+    this->ring = ring;
+    this->filter = filter;
+    this->endPage = endPage;
+    this->relation = getRelationId(tableName);
+    this->table = tableCatalogue.getTable(this->relation);
     this->tableName = tableName;
-    this->pageIndex = pageIndex;
+    if (this->filter) {
+        // start at the first page the filter lets through, if any
+        this->pageIndex = pageIndex - 1;
+        this->pagePointer = 0;
+        this->table->getNextPage(this);
+    } else
+        this->nextPage(pageIndex);
+    bufferManager.adviseMapped(PageId(this->relation, TABLE_PAGE, -1, -1), MADV_SEQUENTIAL);
 }
 
-Cursor::Cursor(string tableName, int assignedBucket, int chainCount) {
+Cursor::Cursor(string tableName, int assignedBucket, int chainCount, BufferRing* ring, PageFilter filter, bool singleBucket) {
     logger.log("Cursor::Cursor");
-    
-    Table *table = tableCatalogue.getTable(tableName);
+    this->ring = ring;
+    this->filter = filter;
+    this->relation = getRelationId(tableName);
+    this->table = tableCatalogue.getTable(this->relation);
     this->bucket = -1;
-    for (int i = assignedBucket; i < table->blocksInBuckets.size(); i++)
-        if (table->blocksInBuckets[i].size())
+    for (int i = assignedBucket; i < this->table->blocksInBuckets.size(); i++)
+    {
+        if (this->table->blocksInBuckets[i].size())
         {
             this->bucket = i;
             break;
         }
+        if (singleBucket)
+            break;
+    }
 
-    if (this->bucket != -1)
-        this->page = bufferManager.getHashPage(tableName, this->bucket, chainCount);
     this->pagePointer = 0;
     this->tableName = tableName;
     this->assignedBucket = assignedBucket;
     this->chainCount = chainCount;
+    if (this->bucket == -1)
+        return;
+    if (this->filter) {
+        // a cursor reading a single bucket only looks at its own chain
+        this->chainCount = chainCount - 1;
+        if (singleBucket)
+            this->table->getNextPage(this, this->chainCount);
+        else
+            this->table->getNextPage(this, this->bucket, this->chainCount);
+    } else
+        this->nextPage(this->bucket, chainCount);
+
+    // the rest of the chain is about to be read
+    for (int chain = this->chainCount + 1; chain < this->table->blocksInBuckets[this->bucket].size(); chain++)
+        bufferManager.adviseMapped(PageId(this->relation, HASH_PAGE, this->bucket, chain), MADV_WILLNEED);
 }
 
 /**
@@ -37,16 +67,16 @@ Cursor::Cursor(string tableName, int assignedBucket, int chainCount) {
  * current row read from the page is indicated by the pagePointer(points to row
  * in page the cursor is pointing to).
  *
- * @return vector<int> 
+ * @return span<const int> 
  */
-vector<int> Cursor::getNext() {
+span<const int> Cursor::getNext() {
     logger.log("Cursor::getNext");
-    vector<int> result = this->page.getRow(this->pagePointer);
+    span<const int> result = this->getRow(this->pagePointer);
     this->pagePointer++;
     if (result.empty()) {
-        tableCatalogue.getTable(this->tableName)->getNextPage(this);
+        this->table->getNextPage(this);
         if (!this->pagePointer) {
-            result = this->page.getRow(this->pagePointer);
+            result = this->getRow(this->pagePointer);
             this->pagePointer++;
         }
     }
@@ -58,19 +88,19 @@ vector<int> Cursor::getNext() {
  * current row read from the page is indicated by the pagePointer(points to row
  * in page the cursor is pointing to).
  *
- * @return vector<int> 
+ * @return span<const int> 
  */
-vector<int> Cursor::getNextInBucket() {
+span<const int> Cursor::getNextInBucket() {
     logger.log("Cursor::getNextInBucket");
-    vector<int> result;
+    span<const int> result;
     if (this->bucket != assignedBucket)
         return result;
-    result = this->page.getRow(this->pagePointer);
+    result = this->getRow(this->pagePointer);
     this->pagePointer++;
     if (result.empty()) {
-        tableCatalogue.getTable(this->tableName)->getNextPage(this, this->chainCount);
+        this->table->getNextPage(this, this->chainCount);
         if (!this->pagePointer) {
-            result = this->page.getRow(this->pagePointer);
+            result = this->getRow(this->pagePointer);
             this->pagePointer++;
         }
     }
@@ -82,25 +112,107 @@ vector<int> Cursor::getNextInBucket() {
  * The index of the current row read from the page is indicated by the 
  * pagePointer(points to row in page the cursor is pointing to). 
  *
- * @return vector<int> 
+ * @return span<const int> 
  */
-vector<int> Cursor::getNextInAllBuckets() {
+span<const int> Cursor::getNextInAllBuckets() {
     logger.log("Cursor::getNextInAllBuckets");
-    vector<int> result;
+    span<const int> result;
     if (this->bucket == -1)
         return result;
-    result = this->page.getRow(this->pagePointer);
+    result = this->getRow(this->pagePointer);
     this->pagePointer++;
     if (result.empty()) {
-        tableCatalogue.getTable(this->tableName)->getNextPage(this, this->bucket, this->chainCount);
+        this->table->getNextPage(this, this->bucket, this->chainCount);
         if (!this->pagePointer) {
-            result = this->page.getRow(this->pagePointer);
+            result = this->getRow(this->pagePointer);
             this->pagePointer++;
         }
     }
     return result;
 }
 
+/**
+ * @brief Hands out the rest of the current page as batch and moves the cursor
+ * past it.
+ *
+ * @param batch 
+ * @return int number of rows in batch
+ */
+int Cursor::takeBatch(RowBatch& batch) {
+    int rowCount = this->getRowCount();
+    if (this->view.values) {
+        batch.values = this->view.getRows(this->pagePointer, this->rowBuffer);
+        batch.columnCount = this->view.columnCount;
+    } else {
+        batch.values = this->page->getRows(this->pagePointer, this->rowBuffer);
+        batch.columnCount = this->page->getColumnCount();
+    }
+    batch.rowCount = rowCount - this->pagePointer;
+    this->pagePointer = rowCount;
+    return batch.rowCount;
+}
+
+/**
+ * @brief Reads the rest of the current page at once, moving on to the next
+ * page if it has been read. The rows stay valid until the next call.
+ *
+ * @param batch 
+ * @return int number of rows in batch, 0 once the table has been read
+ */
+int Cursor::nextBatch(RowBatch& batch) {
+    logger.log("Cursor::nextBatch");
+    batch = RowBatch();
+    while (this->pagePointer >= this->getRowCount()) {
+        int pageIndex = this->pageIndex;
+        this->table->getNextPage(this);
+        if (this->pageIndex == pageIndex)
+            return 0;
+    }
+    return this->takeBatch(batch);
+}
+
+/**
+ * @brief Reads the rest of the current page of the bucket at once, moving on
+ * to the next page of its chain if it has been read.
+ *
+ * @param batch 
+ * @return int number of rows in batch, 0 once the bucket has been read
+ */
+int Cursor::nextBatchInBucket(RowBatch& batch) {
+    logger.log("Cursor::nextBatchInBucket");
+    batch = RowBatch();
+    if (this->bucket != this->assignedBucket)
+        return 0;
+    while (this->pagePointer >= this->getRowCount()) {
+        int chainCount = this->chainCount;
+        this->table->getNextPage(this, chainCount);
+        if (this->chainCount == chainCount)
+            return 0;
+    }
+    return this->takeBatch(batch);
+}
+
+/**
+ * @brief Reads the rest of the current hash page at once, moving on to the
+ * next page of the chain, or to the next bucket, if it has been read.
+ *
+ * @param batch 
+ * @return int number of rows in batch, 0 once every bucket has been read
+ */
+int Cursor::nextBatchInAllBuckets(RowBatch& batch) {
+    logger.log("Cursor::nextBatchInAllBuckets");
+    batch = RowBatch();
+    if (this->bucket == -1)
+        return 0;
+    while (this->pagePointer >= this->getRowCount()) {
+        int bucket = this->bucket, chainCount = this->chainCount;
+        this->table->getNextPage(this, bucket, chainCount);
+        if (this->bucket == bucket && this->chainCount == chainCount)
+            return 0;
+    }
+    return this->takeBatch(batch);
+}
+
 /**
  * @brief Function that loads Page indicated by pageIndex. Now the cursor starts
  * reading from the new page.
@@ -109,7 +221,12 @@ vector<int> Cursor::getNextInAllBuckets() {
  */
 void Cursor::nextPage(int pageIndex) {
     logger.log("Cursor::nextPage");
-    this->page = bufferManager.getTablePage(this->tableName, pageIndex);
+    PageId id(this->relation, TABLE_PAGE, pageIndex);
+    this->view = bufferManager.viewPage(id);
+    if (this->view.values)
+        this->page.release();
+    else
+        this->page = bufferManager.pinTablePage(id, this->ring);
     this->pageIndex = pageIndex;
     this->pagePointer = 0;
 }
@@ -123,8 +240,84 @@ void Cursor::nextPage(int pageIndex) {
  */
 void Cursor::nextPage(int bucket, int chainCount) {
     logger.log("Cursor::nextPage");
-    this->page = bufferManager.getHashPage(this->tableName, bucket, chainCount);
+    PageId id(this->relation, HASH_PAGE, bucket, chainCount);
+    this->view = bufferManager.viewPage(id);
+    if (this->view.values)
+        this->page.release();
+    else
+        this->page = bufferManager.pinHashPage(id, this->ring);
     this->bucket = bucket;
     this->chainCount = chainCount;
     this->pagePointer = 0;
-}
\ No newline at end of file
+}
+/**
+ * @brief Reads row rowIndex of the current page, from the mapping if the page
+ * is viewed or from the pinned page otherwise.
+ *
+ * @param rowIndex 
+ * @return span<const int> empty if there is no such row
+ */
+span<const int> Cursor::getRow(int rowIndex) {
+    if (this->view.values)
+        return this->view.getRow(rowIndex, this->rowBuffer);
+    if (!this->page)
+        return span<const int>();
+    return this->page->getRow(rowIndex, this->rowBuffer);
+}
+
+/**
+ * @brief Number of rows of the current page, 0 if the filter let no page
+ * through.
+ *
+ * @return int 
+ */
+int Cursor::getRowCount() {
+    if (this->view.values)
+        return this->view.rowCount;
+    return this->page ? this->page->getRowCount() : 0;
+}
+
+/**
+ * @brief Checks if the cursor skips page id: its zone map is known and
+ * rejected by the filter of the cursor.
+ *
+ * @param id 
+ * @return true if the page need not be read
+ */
+bool Cursor::skips(const PageId& id) {
+    if (!this->filter)
+        return false;
+    const ZoneMap* zone = bufferManager.getZoneMap(id);
+    return zone && !this->filter(*zone);
+}
+
+/**
+ * @brief Reads the rest of the current page of a PAX table a column at a
+ * time: columns is set to the values of the columns in columnIndices, one
+ * dense array per column, and the cursor moves past them. The next call moves
+ * on to the next page. The columns stay valid until then.
+ *
+ * @param columnIndices 
+ * @param columns 
+ * @return int number of rows in columns, 0 once the table has been read
+ */
+int Cursor::getNextColumns(const vector<int>& columnIndices, vector<span<const int>>& columns) {
+    logger.log("Cursor::getNextColumns");
+    int rowCount = this->getRowCount();
+    while (this->pagePointer >= rowCount) {
+        int pageIndex = this->pageIndex;
+        this->table->getNextPage(this);
+        if (this->pageIndex == pageIndex)
+            return 0;
+        rowCount = this->getRowCount();
+    }
+
+    columns.resize(columnIndices.size());
+    for (int columnCounter = 0; columnCounter < columnIndices.size(); columnCounter++) {
+        span<const int> column = this->view.values ? this->view.getColumn(columnIndices[columnCounter]) : this->page->getColumn(columnIndices[columnCounter]);
+        columns[columnCounter] = column.subspan(this->pagePointer);
+    }
+    int columnRowCount = rowCount - this->pagePointer;
+    this->pagePointer = rowCount;
+    return columnRowCount;
+}
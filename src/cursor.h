@@ -2,30 +2,79 @@
 #define __CURSOR_H
 
 #include"bufferManager.h"
+
+/**
+ * @brief Rows handed out by the batch interface of the Cursor: rowCount rows
+ * of columnCount values each, one row after the other in values. They stay
+ * valid until the cursor moves on.
+ *
+ */
+struct RowBatch {
+    span<const int> values;
+    int rowCount = 0;
+    int columnCount = 0;
+
+    span<const int> operator[](int rowIndex) const {
+        return this->values.subspan((size_t)rowIndex * this->columnCount, this->columnCount);
+    }
+};
+
 /**
  * @brief The cursor is an important component of the system. To read from a
  * table, you need to initialize a cursor. The cursor reads rows from a page one
- * at a time.
+ * at a time. The page it is reading stays pinned in the buffer pool until the
+ * cursor moves on to the next page. Pages of memory mapped tables are viewed
+ * in the mapping instead, unless the pool holds a newer version. Rows are
+ * returned as spans into the page, which stay valid until the next row is
+ * read from the cursor. Unindexed tables stored in PAX layout can also be read
+ * a page of columns at a time. Operators that go through every row can take
+ * the rest of a page at once as a RowBatch (nextBatch and its bucket
+ * variants) instead of calling getNext for each row. A cursor given a
+ * PageFilter skips the pages whose zone map the filter rejects, without
+ * reading them. A cursor binds to its table when it is created, so the table
+ * must outlive it.
  *
  */
+class Table;
+
 class Cursor{
     public:
-    Page page;
+    PageGuard<Page> page;
+    PageView view;
     int pageIndex;
+    // pages from endPage on are not read, e.g. by the morsels of a
+    // ParallelScan
+    int endPage = INT_MAX;
     string tableName;
+    int relation;
+    // bound once, so that moving on to the next page does not look the table
+    // up in the catalogue
+    Table* table = nullptr;
     int pagePointer;
     int assignedBucket;
     int bucket;
     int chainCount;
+    BufferRing* ring = nullptr;
+    // rows of PAX pages are gathered here
+    vector<int> rowBuffer;
+    PageFilter filter;
+    int getRowCount();
+    int takeBatch(RowBatch& batch);
     public:
     Cursor();
-    Cursor(string tableName, int pageIndex);
-    Cursor(string tableName, int bucket, int chainCount);
-    vector<int> getNext();    
-    vector<int> getNextInBucket();
-    vector<int> getNextInAllBuckets();    
+    Cursor(string tableName, int pageIndex, BufferRing* ring = nullptr, PageFilter filter = nullptr, int endPage = INT_MAX);
+    Cursor(string tableName, int bucket, int chainCount, BufferRing* ring = nullptr, PageFilter filter = nullptr, bool singleBucket = false);
+    bool skips(const PageId& id);
+    span<const int> getNext();    
+    span<const int> getNextInBucket();
+    span<const int> getNextInAllBuckets();    
+    int nextBatch(RowBatch& batch);
+    int nextBatchInBucket(RowBatch& batch);
+    int nextBatchInAllBuckets(RowBatch& batch);
     void nextPage(int pageIndex);
     void nextPage(int bucket, int chainCount);
+    span<const int> getRow(int rowIndex);
+    int getNextColumns(const vector<int>& columnIndices, vector<span<const int>>& columns);
 
 };
 
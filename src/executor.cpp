@@ -21,6 +21,7 @@ void executeCommand(){
         case PROJECTION: executePROJECTION(); break;
         case RENAME: executeRENAME(); break;
         case SELECTION: executeSELECTION(); break;
+        case SET: executeSET(); break;
         case SORT: executeSORT(); break;
         case SOURCE: executeSOURCE(); break;
         case TRANSPOSE: executeTRANSPOSE(); break;
@@ -33,4 +34,89 @@ void executeCommand(){
 void printRowCount(int rowCount){
     cout<<"\n\nRow Count: "<<rowCount<<endl;
     return;
-}
\ No newline at end of file
+}
+
+/**
+ * @brief Columns of a row made of a row of table1 followed by a row of
+ * table2, as in CROSS and JOIN. Column names found in both tables are prefixed
+ * with the name of their table, which is followed by 1 and 2 if both tables
+ * are the same.
+ * 
+ * @param table1
+ * 
+ * @param table2
+ * 
+ * @return vector<string>
+ */
+vector<string> getJoinedColumns(Table *table1, Table *table2)
+{
+    string firstRelationName = table1->tableName;
+    string secondRelationName = table2->tableName;
+    if (table1->tableName == table2->tableName)
+    {
+        firstRelationName += "1";
+        secondRelationName += "2";
+    }
+
+    vector<string> columns;
+    for (int columnCounter = 0; columnCounter < table1->columnCount; columnCounter++)
+    {
+        string columnName = table1->columns[columnCounter];
+        if (table2->isColumn(columnName))
+            columnName = firstRelationName + "_" + columnName;
+        columns.emplace_back(columnName);
+    }
+    for (int columnCounter = 0; columnCounter < table2->columnCount; columnCounter++)
+    {
+        string columnName = table2->columns[columnCounter];
+        if (table1->isColumn(columnName))
+            columnName = secondRelationName + "_" + columnName;
+        columns.emplace_back(columnName);
+    }
+    return columns;
+}
+
+/**
+ * @brief Writes rows as the next page of table
+ * 
+ * @param table
+ * 
+ * @param rows
+ * 
+ * @return 
+ */
+void writeRowsAsPage(Table *table, vector<vector<int>> &rows)
+{
+    if (!rows.size())
+        return;
+    table->rowsPerBlockCount.emplace_back(rows.size());
+    bufferManager.writeTablePage(table->tableName, table->blockCount, rows, rows.size());
+    table->blockCount++;
+    rows.clear();
+}
+
+/**
+ * @brief Appends the row made of row1 and row2 to the page of the resultant
+ * table being filled, writing the page once it is full
+ * 
+ * @param resultantTable
+ * 
+ * @param rows rows of the page being filled
+ * 
+ * @param row1
+ * 
+ * @param row2
+ * 
+ * @return 
+ */
+void addJoinedRow(Table *resultantTable, vector<vector<int>> &rows, span<const int> row1, span<const int> row2)
+{
+    vector<int> row;
+    row.reserve(row1.size() + row2.size());
+    row.insert(row.end(), row1.begin(), row1.end());
+    row.insert(row.end(), row2.begin(), row2.end());
+    resultantTable->updateStatistics(row);
+    rows.push_back(std::move(row));
+    if (rows.size() == resultantTable->maxRowsPerBlock)
+        writeRowsAsPage(resultantTable, rows);
+}
@@ -23,11 +23,15 @@ void executePRINT();
 void executePROJECTION();
 void executeRENAME();
 void executeSELECTION();
+void executeSET();
 void executeSORT();
 void executeSOURCE();
 void executeTRANSPOSE();
 
 bool evaluateBinOp(int value1, int value2, BinaryOperator binaryOperator);
 void printRowCount(int rowCount);
+vector<string> getJoinedColumns(Table *table1, Table *table2);
+void writeRowsAsPage(Table *table, vector<vector<int>> &rows);
+void addJoinedRow(Table *resultantTable, vector<vector<int>> &rows, span<const int> row1, span<const int> row2);
 
 #endif
\ No newline at end of file
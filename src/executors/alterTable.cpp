@@ -83,33 +83,24 @@ void executeALTERTABLE()
 
     if (!table->indexed || (table->indexingStrategy == HASH && table->indexedColumn == columnIndex))
     {
-        vector<int> row;
-        Cursor cursor;
         table->indexed = false;
         table->indexingStrategy = NOTHING;
         table->indexedColumn = -1;
 
-        if (!table->indexed)
-        {
-            cursor = table->getCursor();
-            row = cursor.getNext();
-        }
-        else if (table->indexingStrategy == HASH)
-        {
-            cursor = table->getCursor(0, 0);
-            row = cursor.getNextInAllBuckets();
-        }
+        ScanIterator scan = table->getScan();
+        span<const int> row = scan.next();
         vector<vector<int>> rows;
         while (!row.empty())
         {
+            vector<int> newRow(row.begin(), row.end());
             if (parsedQuery.alterTableOperationName == "ADD")
-                row.push_back(0);
+                newRow.push_back(0);
             else if (parsedQuery.alterTableOperationName == "DELETE")
-                row.erase(row.begin() + columnIndex);
+                newRow.erase(newRow.begin() + columnIndex);
 
-            newTable->updateStatistics(row);
+            newTable->updateStatistics(newRow);
 
-            rows.push_back(row);
+            rows.push_back(newRow);
             if (rows.size() == newTable->maxRowsPerBlock)
             {
                 newTable->rowsPerBlockCount.emplace_back(rows.size());
@@ -118,10 +109,7 @@ void executeALTERTABLE()
                 rows.clear();
             }
 
-            if (!table->indexed)
-                row = cursor.getNext();
-            else if (table->indexingStrategy == HASH)
-                row = cursor.getNextInAllBuckets();
+            row = scan.next();
         }
 
         if (rows.size())
@@ -146,20 +134,21 @@ void executeALTERTABLE()
         {
             if (table->blocksInBuckets[bucket].size())
             {
-                Cursor cursor = table->getCursor(bucket, 0);
-                vector<int> row = cursor.getNextInBucket();
+                ScanIterator scan = IndexScan(table, {bucket}, nullptr, nullptr);
+                span<const int> row = scan.next();
                 vector<vector<int>> rows;
                 int chainCount = 0;
 
                 while (!row.empty())
                 {
+                    vector<int> newRow(row.begin(), row.end());
                     if (parsedQuery.alterTableOperationName == "ADD")
-                        row.push_back(0);
+                        newRow.push_back(0);
                     else if (parsedQuery.alterTableOperationName == "DELETE")
-                        row.erase(row.begin() + columnIndex);
+                        newRow.erase(newRow.begin() + columnIndex);
 
-                    newTable->updateStatistics(row);
-                    rows.push_back(row);
+                    newTable->updateStatistics(newRow);
+                    rows.push_back(newRow);
                     if (rows.size() == newTable->maxRowsPerBlock)
                     {
                         newTable->blocksInBuckets[bucket].emplace_back(rows.size());
@@ -168,7 +157,7 @@ void executeALTERTABLE()
                         rows.clear();
                     }
 
-                    row = cursor.getNextInBucket();
+                    row = scan.next();
                 }
 
                 if (rows.size())
@@ -186,13 +175,15 @@ void executeALTERTABLE()
     {
         newTable->sourceFileName = table->sourceFileName;
         string tableName = table->tableName;
+        PageLayout layout = table->layout;
+        bool compressed = table->compressed;
         tableCatalogue.deleteTable(table->tableName);
         vector<vector<int>> rows;
         if (!newTable->indexed || (newTable->indexingStrategy == HASH && newTable->indexedColumn == columnIndex))
         {
             for (int i = 0; i < newTable->blockCount; i++)
             {
-                rows = bufferManager.getTablePage(newTable->tableName, i).data;
+                rows = bufferManager.getTablePage(newTable->tableName, i).getRows();
                 bufferManager.deleteTableFile(newTable->tableName, i);
                 // rows.resize(newTable->rowsPerBlockCount[i]);
                 bufferManager.writeTablePage(tableName, i, rows, rows.size());
@@ -203,7 +194,7 @@ void executeALTERTABLE()
             for (int i = 0; i < newTable->blocksInBuckets.size(); i++)
                 for (int j = 0; j < newTable->blocksInBuckets[i].size(); j++)
                 {
-                    rows = bufferManager.getHashPage(newTable->tableName, i, j).data;
+                    rows = bufferManager.getHashPage(newTable->tableName, i, j).getRows();
                     bufferManager.deleteHashFile(newTable->tableName, i, j);
                     bufferManager.writeHashPage(tableName, i, j, rows);
                 }
@@ -211,6 +202,8 @@ void executeALTERTABLE()
         
         tableCatalogue.replaceTableName(newTable->tableName, tableName);
         newTable->tableName = tableName;
+        newTable->setLayout(layout);
+        newTable->setCompressed(compressed);
     
         if (btree)
             newTable->bTreeIndex(btreeColName, fanout);
@@ -87,7 +87,7 @@ void executeBULKINSERT()
                 table->updateStatistics(row);
                 if (pageCounter == table->maxRowsPerBlock - table->rowsPerBlockCount[table->blockCount - 1])
                 {
-                    vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(table->tableName, table->blockCount - 1).data;
+                    vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(table->tableName, table->blockCount - 1).getRows();
                     rowsInLastPage.resize(table->rowsPerBlockCount[table->blockCount - 1]);
                     rowsInLastPage.insert(std::end(rowsInLastPage), std::begin(rowsInPage), std::end(rowsInPage));
                     bufferManager.writeTablePage(table->tableName, table->blockCount - 1, rowsInLastPage, table->maxRowsPerBlock);
@@ -121,7 +121,7 @@ void executeBULKINSERT()
 
         if (pageCounter <= table->maxRowsPerBlock - table->rowsPerBlockCount[table->blockCount - 1])
         {
-            vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(table->tableName, table->blockCount - 1).data;
+            vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(table->tableName, table->blockCount - 1).getRows();
             rowsInLastPage.resize(table->rowsPerBlockCount[table->blockCount - 1]);
             rowsInLastPage.insert(std::end(rowsInLastPage), std::begin(rowsInPage), std::end(rowsInPage));
             bufferManager.writeTablePage(table->tableName, table->blockCount - 1, rowsInLastPage, table->rowsPerBlockCount[table->blockCount - 1] + pageCounter);
@@ -37,94 +37,52 @@ bool semanticParseCROSS()
     return true;
 }
 
+/**
+ * @brief Block nested-loop cross product. The second table is held in memory
+ * a chunk of pages at a time, as many as the buffer has room for less a page
+ * to read the first table through and a page of result, and the first table
+ * is read once per chunk. While the second table fits in one chunk, rows come
+ * out in the order of the first table. The result is written as table pages
+ * directly.
+ * 
+ */
 void executeCROSS()
 {
     logger.log("executeCROSS");
 
     Table *table1 = tableCatalogue.getTable(parsedQuery.crossFirstRelationName);
     Table *table2 = tableCatalogue.getTable(parsedQuery.crossSecondRelationName);
+    Table *resultantTable = new Table(parsedQuery.crossResultRelationName, getJoinedColumns(table1, table2));
 
-    vector<string> columns;
-
-    //If both tables are the same i.e. CROSS a a, then names are indexed as a1 and a2
-    if(table1->tableName == table2->tableName){
-        parsedQuery.crossFirstRelationName += "1";
-        parsedQuery.crossSecondRelationName += "2";
-    }
-
-    //Creating list of column names
-    for (int columnCounter = 0; columnCounter < table1->columnCount; columnCounter++)
+    int chunkRowCount = max((int)BLOCK_COUNT - 2, 1) * table2->maxRowsPerBlock;
+    vector<vector<int>> chunk, rows;
+    BufferRing ring1(table1->blockCount), ring2(table2->blockCount);
+    ScanIterator scan2 = table2->getScan(&ring2);
+    span<const int> row2 = scan2.next();
+    RowBatch batch1;
+    while (!row2.empty())
     {
-        string columnName = table1->columns[columnCounter];
-        if (table2->isColumn(columnName))
+        chunk.clear();
+        while (!row2.empty() && chunk.size() < chunkRowCount)
         {
-            columnName = parsedQuery.crossFirstRelationName + "_" + columnName;
+            chunk.emplace_back(row2.begin(), row2.end());
+            row2 = scan2.next();
         }
-        columns.emplace_back(columnName);
-    }
 
-    for (int columnCounter = 0; columnCounter < table2->columnCount; columnCounter++)
-    {
-        string columnName = table2->columns[columnCounter];
-        if (table1->isColumn(columnName))
-        {
-            columnName = parsedQuery.crossSecondRelationName + "_" + columnName;
-        }
-        columns.emplace_back(columnName);
+        ScanIterator scan1 = table1->getScan(&ring1);
+        while (scan1.nextBatch(batch1))
+            for (int rowCounter1 = 0; rowCounter1 < batch1.rowCount; rowCounter1++)
+                for (const vector<int> &chunkRow : chunk)
+                    addJoinedRow(resultantTable, rows, batch1[rowCounter1], chunkRow);
     }
+    writeRowsAsPage(resultantTable, rows);
 
-    Table *resultantTable = new Table(parsedQuery.crossResultRelationName, columns);
-    resultantTable->writeRow<string>(columns);
-    
-    Cursor cursor1;
-    vector<int> row1;
-
-    if (!table1->indexed)
+    if (resultantTable->rowCount)
+        tableCatalogue.insertTable(resultantTable);
+    else
     {
-        cursor1 = table1->getCursor();
-        row1 = cursor1.getNext();
+        cout << "Empty Table" << endl;
+        resultantTable->unload();
+        delete resultantTable;
     }
-    else if (table1->indexingStrategy == HASH || table1->indexingStrategy == BTREE)
-    {
-        cursor1 = table1->getCursor(0, 0);
-        row1 = cursor1.getNextInAllBuckets();
-    }
-
-    vector<int> row2;
-    vector<int> resultantRow;
-    resultantRow.reserve(resultantTable->columnCount);
-
-    while (!row1.empty())
-    {
-        Cursor cursor2;
-        if (!table2->indexed)
-        {
-            cursor2 = table2->getCursor();
-            row2 = cursor2.getNext();
-        }
-        else if (table2->indexingStrategy == HASH || table2->indexingStrategy == BTREE)
-        {
-            cursor2 = table2->getCursor(0, 0);
-            row2 = cursor2.getNextInAllBuckets();
-        }
-
-        while (!row2.empty())
-        {
-            resultantRow = row1;
-            resultantRow.insert(resultantRow.end(), row2.begin(), row2.end());
-            resultantTable->writeRow<int>(resultantRow);
-            if (!table2->indexed)
-                row2 = cursor2.getNext();
-            else if (table2->indexingStrategy == HASH || table2->indexingStrategy == BTREE)
-                row2 = cursor2.getNextInAllBuckets();
-        }
-
-        if (!table1->indexed)
-            row1 = cursor1.getNext();
-        else if (table1->indexingStrategy == HASH || table1->indexingStrategy == BTREE)
-            row1 = cursor1.getNextInAllBuckets();
-    }
-    resultantTable->blockify();
-    tableCatalogue.insertTable(resultantTable);
-    return;
-}
\ No newline at end of file
+}
@@ -36,8 +36,66 @@ bool semanticParseDISTINCT()
     return true;
 }
 
+/**
+ * @brief Keeps the first occurrence of every row, in the order the rows are
+ * read. Every morsel of the relation drops its own duplicates on a worker
+ * thread, and the rows left are checked against those of earlier morsels as
+ * they are written.
+ * 
+ */
 void executeDISTINCT()
 {
     logger.log("executeDISTINCT");
-    return;
-}
\ No newline at end of file
+    Table *table = tableCatalogue.getTable(parsedQuery.distinctRelationName);
+    Table *resultantTable = new Table(parsedQuery.distinctResultRelationName, table->columns);
+
+    set<vector<int>> seen;
+    vector<vector<int>> rows;
+    ParallelScan scan(table);
+    scan.run<vector<vector<int>>>([&](ScanIterator &morsel, vector<vector<int>> &morselRows)
+    {
+        set<vector<int>> morselSeen;
+        RowBatch batch;
+        while (morsel.nextBatch(batch))
+            for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+            {
+                vector<int> row(batch[rowCounter].begin(), batch[rowCounter].end());
+                if (morselSeen.insert(row).second)
+                    morselRows.push_back(row);
+            }
+    },
+    [&](vector<vector<int>> &morselRows)
+    {
+        for (vector<int> &row : morselRows)
+        {
+            if (!seen.insert(row).second)
+                continue;
+            resultantTable->updateStatistics(row);
+            rows.push_back(row);
+            if (rows.size() == resultantTable->maxRowsPerBlock)
+            {
+                resultantTable->rowsPerBlockCount.emplace_back(rows.size());
+                bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
+                resultantTable->blockCount++;
+                rows.clear();
+            }
+        }
+    });
+
+    if (rows.size())
+    {
+        resultantTable->rowsPerBlockCount.emplace_back(rows.size());
+        bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
+        resultantTable->blockCount++;
+        rows.clear();
+    }
+
+    if (resultantTable->rowCount)
+        tableCatalogue.insertTable(resultantTable);
+    else
+    {
+        cout << "Empty Table" << endl;
+        resultantTable->unload();
+        delete resultantTable;
+    }
+}
@@ -31,6 +31,7 @@ bool semanticParseEXPORT()
 void executeEXPORT()
 {
     logger.log("executeEXPORT");
+    bufferManager.flushWrites();
     if (tableCatalogue.isTable(parsedQuery.exportRelationOrMatrixName))
     {
         Table* table = tableCatalogue.getTable(parsedQuery.exportRelationOrMatrixName);
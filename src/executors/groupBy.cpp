@@ -55,62 +55,89 @@ void executeGROUPBY()
     int firstColumnIndex = table->getColumnIndex(parsedQuery.groupByGroupingAttributeName);
     int secondColumnIndex = table->getColumnIndex(parsedQuery.groupByAttributeName);
 
-    map<int, int> result;
-    map<int, int> count;
-
-    vector<int> row;
-    Cursor cursor;
-
-    if (!table->indexed)
-    {
-        cursor = table->getCursor();
-        row = cursor.getNext();
-    }
-    else
+    // the aggregate of every group so far, and for AVG the number of values
+    // summed up in it
+    struct Aggregate
     {
-        cursor = table->getCursor(0, 0);
-        row = cursor.getNextInAllBuckets();
-    }
+        map<int, int> result;
+        map<int, int> count;
+    };
 
-    while (!row.empty())
+    auto aggregate = [&](Aggregate &partial, int group, int value)
     {
+        map<int, int> &result = partial.result;
         if (parsedQuery.groupByOperatorName == "MAX")
         {
-            if (result.find(row[firstColumnIndex]) == result.end())
-                result[row[firstColumnIndex]] = row[secondColumnIndex];
-            result[row[firstColumnIndex]] = max(result[row[firstColumnIndex]], row[secondColumnIndex]);
+            if (result.find(group) == result.end())
+                result[group] = value;
+            result[group] = max(result[group], value);
         }
         else if (parsedQuery.groupByOperatorName == "MIN")
         {
-            if (result.find(row[firstColumnIndex]) == result.end())
-                result[row[firstColumnIndex]] = row[secondColumnIndex];
-            result[row[firstColumnIndex]] = min(result[row[firstColumnIndex]], row[secondColumnIndex]);
+            if (result.find(group) == result.end())
+                result[group] = value;
+            result[group] = min(result[group], value);
         }
         else
         {
-            result[row[firstColumnIndex]] += row[secondColumnIndex];
+            result[group] += value;
             if (parsedQuery.groupByOperatorName == "AVG")
-                count[row[firstColumnIndex]]++;
+                partial.count[group]++;
         }
+    };
 
-        if (!table->indexed)
-            row = cursor.getNext();
+    // every morsel is aggregated on its own on a worker thread, and the
+    // partial aggregates are then merged into the final one
+    Aggregate final;
+    ParallelScan scan(table);
+    scan.run<Aggregate>([&](ScanIterator &morsel, Aggregate &partial)
+    {
+        if (!table->indexed && table->layout == PAX_LAYOUT)
+        {
+            // only the two columns are read, a page at a time
+            vector<span<const int>> columns;
+            int rowCount;
+            while ((rowCount = morsel.nextColumns({firstColumnIndex, secondColumnIndex}, columns)))
+                for (int rowCounter = 0; rowCounter < rowCount; rowCounter++)
+                    aggregate(partial, columns[0][rowCounter], columns[1][rowCounter]);
+        }
         else
-            row = cursor.getNextInAllBuckets();
-    }
+        {
+            RowBatch batch;
+            while (morsel.nextBatch(batch))
+                for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+                    aggregate(partial, batch[rowCounter][firstColumnIndex], batch[rowCounter][secondColumnIndex]);
+        }
+    },
+    [&](Aggregate &partial)
+    {
+        for (auto it: partial.result)
+        {
+            // the largest of the largest values is the largest value, and
+            // so on, while sums are added up
+            if (parsedQuery.groupByOperatorName == "MAX" || parsedQuery.groupByOperatorName == "MIN")
+                aggregate(final, it.first, it.second);
+            else
+                final.result[it.first] += it.second;
+        }
+        for (auto it: partial.count)
+            final.count[it.first] += it.second;
+    });
+    map<int, int> &result = final.result;
+    map<int, int> &count = final.count;
 
     vector<vector<int>> rows;
     for (auto it: result)
     {
         if (parsedQuery.groupByOperatorName == "AVG")
         {
-            resultantTable->updateStatistics({it.first, it.second/count[it.first]});
             rows.push_back({it.first, it.second/count[it.first]});
+            resultantTable->updateStatistics(rows.back());
         }
         else
         {
-            resultantTable->updateStatistics({it.first, it.second});
             rows.push_back({it.first, it.second});
+            resultantTable->updateStatistics(rows.back());
         }
 
         if (rows.size() == resultantTable->maxRowsPerBlock)
@@ -63,8 +63,655 @@ bool semanticParseJOIN()
     return true;
 }
 
+// times a skewed partition is split again before it is joined in memory anyway
+#define MAX_PARTITION_LEVEL 3
+
+/**
+ * @brief One input of a join: the table and its join column, and whether its
+ * columns come first in the result
+ */
+struct JoinInput
+{
+    Table *table;
+    int columnIndex;
+    bool first;
+};
+
+/**
+ * @brief Number of pages of table, whether it is indexed or not
+ * 
+ * @param table
+ * 
+ * @return int
+ */
+int getPageCount(Table *table)
+{
+    if (!table->indexed)
+        return table->blockCount;
+    int pageCount = 0;
+    for (const vector<int> &bucket : table->blocksInBuckets)
+        pageCount += bucket.size();
+    return pageCount;
+}
+
+/**
+ * @brief Partition a value falls in. The hash is seeded with the level, so
+ * that a partition split again spreads its values over new partitions.
+ * 
+ * @param value
+ * 
+ * @param level
+ * 
+ * @param partitionCount
+ * 
+ * @return int
+ */
+int getPartition(int value, int level, int partitionCount)
+{
+    uint64_t hash = (uint32_t)value + (level + 1) * 0x9E3779B97F4A7C15ULL;
+    hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBULL;
+    return (hash ^ (hash >> 31)) % partitionCount;
+}
+
+/**
+ * @brief Splits input into partitionCount temporary tables by the hash of its
+ * join column. A page of every partition is filled in memory at a time.
+ * 
+ * @param input
+ * 
+ * @param partitionCount
+ * 
+ * @param level
+ * 
+ * @param prefix names of the partitions are prefix followed by their number
+ * 
+ * @return vector<Table*>
+ */
+vector<Table *> partitionInput(JoinInput input, int partitionCount, int level, string prefix)
+{
+    logger.log("partitionInput");
+    vector<Table *> partitions(partitionCount);
+    for (int partition = 0; partition < partitionCount; partition++)
+    {
+        partitions[partition] = new Table(prefix + to_string(partition), input.table->columns);
+        // so that the statistics hold the smallest and largest values of the
+        // rows of the partition, which hashJoin checks
+        fill(partitions[partition]->smallestInColumns.begin(), partitions[partition]->smallestInColumns.end(), INT_MAX);
+        fill(partitions[partition]->largestInColumns.begin(), partitions[partition]->largestInColumns.end(), INT_MIN);
+        tableCatalogue.insertTable(partitions[partition]);
+    }
+
+    vector<vector<vector<int>>> pages(partitionCount);
+    BufferRing ring(input.table->blockCount);
+    ScanIterator scan = input.table->getScan(&ring);
+    RowBatch batch;
+    while (scan.nextBatch(batch))
+        for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+        {
+            span<const int> row = batch[rowCounter];
+            int partition = getPartition(row[input.columnIndex], level, partitionCount);
+            partitions[partition]->updateStatistics(row);
+            pages[partition].emplace_back(row.begin(), row.end());
+            if (pages[partition].size() == partitions[partition]->maxRowsPerBlock)
+                writeRowsAsPage(partitions[partition], pages[partition]);
+        }
+    for (int partition = 0; partition < partitionCount; partition++)
+        writeRowsAsPage(partitions[partition], pages[partition]);
+    return partitions;
+}
+
+/**
+ * @brief Joins build, which fits in memory, with probe: the rows of build are
+ * put in a hash table on their join value, which every row of probe is then
+ * looked up in.
+ * 
+ * @param build
+ * 
+ * @param probe
+ * 
+ * @param resultantTable
+ * 
+ * @param rows rows of the page of the resultant table being filled
+ * 
+ * @return 
+ */
+void buildAndProbe(JoinInput build, JoinInput probe, Table *resultantTable, vector<vector<int>> &rows)
+{
+    logger.log("buildAndProbe");
+    vector<vector<int>> buildRows;
+    unordered_map<int, vector<int>> rowsByValue;
+    ScanIterator buildScan = build.table->getScan();
+    RowBatch batch;
+    while (buildScan.nextBatch(batch))
+        for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+        {
+            span<const int> row = batch[rowCounter];
+            rowsByValue[row[build.columnIndex]].push_back(buildRows.size());
+            buildRows.emplace_back(row.begin(), row.end());
+        }
+
+    BufferRing ring(probe.table->blockCount);
+    ScanIterator probeScan = probe.table->getScan(&ring);
+    while (probeScan.nextBatch(batch))
+        for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+        {
+            span<const int> row = batch[rowCounter];
+            auto match = rowsByValue.find(row[probe.columnIndex]);
+            if (match == rowsByValue.end())
+                continue;
+            for (int buildRow : match->second)
+                if (build.first)
+                    addJoinedRow(resultantTable, rows, buildRows[buildRow], row);
+                else
+                    addJoinedRow(resultantTable, rows, row, buildRows[buildRow]);
+        }
+}
+
+/**
+ * @brief Grace hash join of two inputs on equal join values. The smaller
+ * input is built into an in-memory hash table if it fits in the buffer
+ * (BLOCK_COUNT pages, less a page to read the other input through and a page
+ * of result). Otherwise both inputs are split into partitions on disk by the
+ * hash of their join value, so that matching rows land in partitions of the
+ * same number, and each pair of partitions is joined the same way, which
+ * splits the partitions that are still too large again, with a new hash.
+ * 
+ * @param input1
+ * 
+ * @param input2
+ * 
+ * @param level how many times the inputs have been partitioned already
+ * 
+ * @param prefix prefix of the names of the partitions of this level
+ * 
+ * @param resultantTable
+ * 
+ * @param rows rows of the page of the resultant table being filled
+ * 
+ * @return 
+ */
+void hashJoin(JoinInput input1, JoinInput input2, int level, string prefix, Table *resultantTable, vector<vector<int>> &rows)
+{
+    logger.log("hashJoin");
+    JoinInput build = input1, probe = input2;
+    if (getPageCount(probe.table) < getPageCount(build.table))
+        swap(build, probe);
+    int budget = max((int)BLOCK_COUNT, 3);
+    int buildPageCount = getPageCount(build.table);
+    if (buildPageCount <= budget - 2 || level == MAX_PARTITION_LEVEL)
+    {
+        buildAndProbe(build, probe, resultantTable, rows);
+        return;
+    }
+
+    // a partition per budget of the build input, with room for an uneven
+    // spread, and a page in memory for each of them
+    int partitionCount = ceil(buildPageCount * 1.25 / (budget - 2));
+    partitionCount = min(max(partitionCount, 2), budget - 1);
+    vector<Table *> buildPartitions = partitionInput(build, partitionCount, level, prefix + "B");
+    vector<Table *> probePartitions = partitionInput(probe, partitionCount, level, prefix + "P");
+
+    for (int partition = 0; partition < partitionCount; partition++)
+    {
+        Table *buildPartition = buildPartitions[partition], *probePartition = probePartitions[partition];
+        if (buildPartition->rowCount && probePartition->rowCount)
+        {
+            // a partition whose smallest and largest join value are equal
+            // holds one join value only, and splitting it again would not help
+            bool oneValue = buildPartition->smallestInColumns[build.columnIndex] == buildPartition->largestInColumns[build.columnIndex];
+            int nextLevel = oneValue ? MAX_PARTITION_LEVEL : level + 1;
+            JoinInput nextBuild = {buildPartition, build.columnIndex, build.first};
+            JoinInput nextProbe = {probePartition, probe.columnIndex, probe.first};
+            hashJoin(nextBuild, nextProbe, nextLevel, prefix + to_string(partition) + "_", resultantTable, rows);
+        }
+        tableCatalogue.deleteTable(buildPartition->tableName);
+        tableCatalogue.deleteTable(probePartition->tableName);
+    }
+}
+
+/**
+ * @brief Joins on any condition by comparing every pair of rows. The first
+ * input is read into memory a chunk of pages at a time, and the second input
+ * is read once for every chunk.
+ * 
+ * @param input1
+ * 
+ * @param input2
+ * 
+ * @param resultantTable
+ * 
+ * @param rows rows of the page of the resultant table being filled
+ * 
+ * @return 
+ */
+void nestedLoopJoin(JoinInput input1, JoinInput input2, Table *resultantTable, vector<vector<int>> &rows)
+{
+    logger.log("nestedLoopJoin");
+    int chunkRowCount = max((int)BLOCK_COUNT - 2, 1) * input1.table->maxRowsPerBlock;
+    vector<vector<int>> chunk;
+    BufferRing ring1(input1.table->blockCount), ring2(input2.table->blockCount);
+    ScanIterator scan1 = input1.table->getScan(&ring1);
+    span<const int> row1 = scan1.next();
+    RowBatch batch;
+    while (!row1.empty())
+    {
+        chunk.clear();
+        while (!row1.empty() && chunk.size() < chunkRowCount)
+        {
+            chunk.emplace_back(row1.begin(), row1.end());
+            row1 = scan1.next();
+        }
+
+        ScanIterator scan2 = input2.table->getScan(&ring2);
+        while (scan2.nextBatch(batch))
+            for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+            {
+                span<const int> row2 = batch[rowCounter];
+                for (const vector<int> &chunkRow : chunk)
+                    if (evaluateBinOp(chunkRow[input1.columnIndex], row2[input2.columnIndex], parsedQuery.joinBinaryOperator))
+                        addJoinedRow(resultantTable, rows, chunkRow, row2);
+            }
+    }
+}
+
+/**
+ * @brief Checks if the rows of input are read in ascending order of its join
+ * column, e.g. the result of an ascending SORT. Stops at the first row out of
+ * order.
+ * 
+ * @param input
+ * 
+ * @return true if the rows are in order
+ */
+bool isSorted(JoinInput input)
+{
+    logger.log("isSorted");
+    BufferRing ring(input.table->blockCount);
+    ScanIterator scan = input.table->getScan(&ring);
+    span<const int> row = scan.next();
+    int previous = INT_MIN;
+    while (!row.empty())
+    {
+        if (row[input.columnIndex] < previous)
+            return false;
+        previous = row[input.columnIndex];
+        row = scan.next();
+    }
+    return true;
+}
+
+/**
+ * @brief Checks if input is a B+ tree on its join column, whose buckets hold
+ * ranges of join values in order
+ * 
+ * @param input
+ * 
+ * @return true if it is
+ */
+bool isIndexedOn(JoinInput input)
+{
+    return input.table->indexingStrategy == BTREE && input.table->indexedColumn == input.columnIndex;
+}
+
+/**
+ * @brief Reads the rows of a join input in ascending order of its join
+ * column, as many times as rewind is called. How depends on the input:
+ * 
+ * <p>
+ * Rows that are already in order are read as they are. The buckets of a B+
+ * tree on the join column are read in key order, and each is sorted in
+ * memory once read. Otherwise the input is copied to a temporary table which
+ * is sorted with Table::sort, and the sorted copy is read.
+ * 
+ */
+class SortedInput
+{
+    JoinInput input;
+    Table *sortedTable = nullptr;
+    BufferRing ring;
+    ScanIterator scan;
+    // the rows of the bucket being read, for a B+ tree on the join column
+    int bucket = -1;
+    vector<vector<int>> bucketRows;
+    int bucketPointer = 0;
+
+public:
+    SortedInput(JoinInput input, bool sorted, string tempName);
+    SortedInput(const SortedInput &) = delete;
+    ~SortedInput();
+    void rewind();
+    span<const int> next();
+};
+
+/**
+ * @brief Construct a new SortedInput, sorting a copy of input if its rows are
+ * not in order already
+ * 
+ * @param input
+ * 
+ * @param sorted whether the rows of input are known to be in order
+ * 
+ * @param tempName name of the sorted copy of input, if one is needed
+ */
+SortedInput::SortedInput(JoinInput input, bool sorted, string tempName) : ring(getPageCount(input.table))
+{
+    logger.log("SortedInput::SortedInput");
+    this->input = input;
+    if (sorted || isIndexedOn(input))
+        return;
+
+    this->sortedTable = new Table(tempName, input.table->columns);
+    tableCatalogue.insertTable(this->sortedTable);
+    vector<vector<int>> rows;
+    ScanIterator scan = input.table->getScan(&this->ring);
+    RowBatch batch;
+    while (scan.nextBatch(batch))
+        for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+        {
+            this->sortedTable->updateStatistics(batch[rowCounter]);
+            rows.emplace_back(batch[rowCounter].begin(), batch[rowCounter].end());
+            if (rows.size() == this->sortedTable->maxRowsPerBlock)
+                writeRowsAsPage(this->sortedTable, rows);
+        }
+    writeRowsAsPage(this->sortedTable, rows);
+    // the sorted copy is written to the hash pages of a single bucket
+    if (this->sortedTable->rowCount)
+        this->sortedTable->sort(max((int)BLOCK_COUNT, 3), input.table->columns[input.columnIndex], 1.0, 0);
+}
+
+SortedInput::~SortedInput()
+{
+    if (!this->sortedTable)
+        return;
+    // let go of the page being read before the pages are deleted
+    this->scan = ScanIterator();
+    bufferManager.deleteSegment(this->sortedTable->tableName, HASH_PAGE);
+    tableCatalogue.deleteTable(this->sortedTable->tableName);
+}
+
+/**
+ * @brief Starts reading the rows from the first one again
+ * 
+ */
+void SortedInput::rewind()
+{
+    logger.log("SortedInput::rewind");
+    if (this->sortedTable)
+        this->scan = BucketScan(this->sortedTable, &this->ring, nullptr);
+    else if (!isIndexedOn(this->input))
+        this->scan = this->input.table->getScan(&this->ring);
+    this->bucket = -1;
+    this->bucketRows.clear();
+    this->bucketPointer = 0;
+}
+
+/**
+ * @brief Reads the next row. The row stays valid until the next call.
+ * 
+ * @return span<const int> empty once every row has been read
+ */
+span<const int> SortedInput::next()
+{
+    if (!isIndexedOn(this->input))
+        return this->scan.next();
+
+    int columnIndex = this->input.columnIndex;
+    while (this->bucketPointer == this->bucketRows.size())
+    {
+        if (++this->bucket == this->input.table->blocksInBuckets.size())
+            return span<const int>();
+        this->bucketRows.clear();
+        this->bucketPointer = 0;
+        ScanIterator bucketScan = IndexScan(this->input.table, {this->bucket}, &this->ring, nullptr);
+        RowBatch batch;
+        while (bucketScan.nextBatch(batch))
+            for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+                this->bucketRows.emplace_back(batch[rowCounter].begin(), batch[rowCounter].end());
+        std::sort(this->bucketRows.begin(), this->bucketRows.end(), [&](const vector<int> &a, const vector<int> &b) {
+            return a[columnIndex] < b[columnIndex];
+        });
+    }
+    return this->bucketRows[this->bucketPointer++];
+}
+
+/**
+ * @brief Sort-merge join of two inputs read in order of their join columns.
+ * 
+ * <p>
+ * For equality the inputs are merged in a single pass over each, holding the
+ * rows of the second input that share a join value in memory. For the other
+ * comparisons, the first input is read a chunk of pages at a time, and the
+ * second input once per chunk: as both are in order, the rows of the chunk
+ * matching a row of the second input are a run at the start (for < and <=)
+ * or at the end (for > and >=) of the chunk, whose bound only moves forward.
+ * 
+ * @param input1
+ * 
+ * @param input2
+ * 
+ * @param sorted1 whether the rows of input1 are known to be in order
+ * 
+ * @param sorted2 whether the rows of input2 are known to be in order
+ * 
+ * @param resultantTable
+ * 
+ * @param rows rows of the page of the resultant table being filled
+ * 
+ * @return 
+ */
+void sortMergeJoin(JoinInput input1, JoinInput input2, bool sorted1, bool sorted2, Table *resultantTable, vector<vector<int>> &rows)
+{
+    logger.log("sortMergeJoin");
+    BinaryOperator binaryOperator = parsedQuery.joinBinaryOperator;
+    int columnIndex1 = input1.columnIndex, columnIndex2 = input2.columnIndex;
+    SortedInput sortedInput1(input1, sorted1, parsedQuery.joinResultRelationName + "_temp_1");
+    SortedInput sortedInput2(input2, sorted2, parsedQuery.joinResultRelationName + "_temp_2");
+    sortedInput1.rewind();
+    span<const int> row1 = sortedInput1.next(), row2;
+
+    if (binaryOperator == EQUAL)
+    {
+        sortedInput2.rewind();
+        row2 = sortedInput2.next();
+        vector<vector<int>> group;
+        while (!row1.empty() && !row2.empty())
+        {
+            if (row1[columnIndex1] < row2[columnIndex2])
+                row1 = sortedInput1.next();
+            else if (row1[columnIndex1] > row2[columnIndex2])
+                row2 = sortedInput2.next();
+            else
+            {
+                int value = row2[columnIndex2];
+                group.clear();
+                while (!row2.empty() && row2[columnIndex2] == value)
+                {
+                    group.emplace_back(row2.begin(), row2.end());
+                    row2 = sortedInput2.next();
+                }
+                while (!row1.empty() && row1[columnIndex1] == value)
+                {
+                    for (const vector<int> &groupRow : group)
+                        addJoinedRow(resultantTable, rows, row1, groupRow);
+                    row1 = sortedInput1.next();
+                }
+            }
+        }
+        return;
+    }
+
+    bool prefix = binaryOperator == LESS_THAN || binaryOperator == LEQ;
+    int chunkRowCount = max((int)BLOCK_COUNT - 2, 1) * input1.table->maxRowsPerBlock;
+    vector<vector<int>> chunk;
+    while (!row1.empty())
+    {
+        chunk.clear();
+        while (!row1.empty() && chunk.size() < chunkRowCount)
+        {
+            chunk.emplace_back(row1.begin(), row1.end());
+            row1 = sortedInput1.next();
+        }
+
+        // chunk[0, bound) satisfy the comparison for < and <=, and
+        // chunk[bound, end) for > and >=
+        int bound = 0;
+        sortedInput2.rewind();
+        for (row2 = sortedInput2.next(); !row2.empty(); row2 = sortedInput2.next())
+        {
+            int value = row2[columnIndex2];
+            while (bound < chunk.size() && (prefix ? evaluateBinOp(chunk[bound][columnIndex1], value, binaryOperator)
+                                                   : !evaluateBinOp(chunk[bound][columnIndex1], value, binaryOperator)))
+                bound++;
+            if (!prefix && bound == chunk.size())
+                break;
+            int first = prefix ? 0 : bound, end = prefix ? bound : chunk.size();
+            for (int chunkRow = first; chunkRow < end; chunkRow++)
+                addJoinedRow(resultantTable, rows, chunk[chunkRow], row2);
+        }
+    }
+}
+
+/**
+ * @brief Checks if input has an index, hash or B+ tree, on its join column
+ * 
+ * @param input
+ * 
+ * @return true if it does
+ */
+bool canProbe(JoinInput input)
+{
+    return (input.table->indexingStrategy == HASH || input.table->indexingStrategy == BTREE) && input.table->indexedColumn == input.columnIndex;
+}
+
+/**
+ * @brief Estimated pages read by an index nested-loop join: every page of
+ * outer, and for each of its rows a bucket chain of inner, of the average
+ * length
+ * 
+ * @param outer
+ * 
+ * @param inner
+ * 
+ * @return double
+ */
+double getIndexJoinCost(JoinInput outer, JoinInput inner)
+{
+    int bucketCount = 0;
+    for (const vector<int> &bucket : inner.table->blocksInBuckets)
+        if (bucket.size())
+            bucketCount++;
+    double chainLength = max(1.0, (double)getPageCount(inner.table) / max(bucketCount, 1));
+    return getPageCount(outer.table) + outer.table->rowCount * chainLength;
+}
+
+/**
+ * @brief Estimated pages read and written by a hash join: each input read
+ * once if the smaller one fits in the buffer, or partitioned and read back
+ * otherwise
+ * 
+ * @param input1
+ * 
+ * @param input2
+ * 
+ * @return double
+ */
+double getHashJoinCost(JoinInput input1, JoinInput input2)
+{
+    int pageCount1 = getPageCount(input1.table), pageCount2 = getPageCount(input2.table);
+    if (min(pageCount1, pageCount2) <= max((int)BLOCK_COUNT, 3) - 2)
+        return pageCount1 + pageCount2;
+    return 3.0 * (pageCount1 + pageCount2);
+}
+
+/**
+ * @brief Joins on equal join values by looking every row of outer up in the
+ * index of inner on its join column, reading only the buckets that may hold
+ * the value, and within them only the pages whose range holds it.
+ * 
+ * @param outer
+ * 
+ * @param inner
+ * 
+ * @param resultantTable
+ * 
+ * @param rows rows of the page of the resultant table being filled
+ * 
+ * @return 
+ */
+void indexNestedLoopJoin(JoinInput outer, JoinInput inner, Table *resultantTable, vector<vector<int>> &rows)
+{
+    logger.log("indexNestedLoopJoin");
+    int columnIndex = inner.columnIndex;
+    BufferRing ring(outer.table->blockCount);
+    ScanIterator outerScan = outer.table->getScan(&ring);
+    // batch stays valid while inner is read, as outerScan does not move
+    RowBatch batch, innerBatch;
+    while (outerScan.nextBatch(batch))
+        for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+        {
+            span<const int> row = batch[rowCounter];
+            int value = row[outer.columnIndex];
+            PageFilter filter = [=](const ZoneMap &zone) {
+                return columnIndex >= (int)zone.smallest.size() || (zone.smallest[columnIndex] <= value && value <= zone.largest[columnIndex]);
+            };
+            ScanIterator innerScan = IndexScan(inner.table, inner.table->getBucketsOf(value), nullptr, filter);
+            while (innerScan.nextBatch(innerBatch))
+                for (int innerRowCounter = 0; innerRowCounter < innerBatch.rowCount; innerRowCounter++)
+                {
+                    span<const int> innerRow = innerBatch[innerRowCounter];
+                    if (innerRow[columnIndex] != value)
+                        continue;
+                    if (outer.first)
+                        addJoinedRow(resultantTable, rows, row, innerRow);
+                    else
+                        addJoinedRow(resultantTable, rows, innerRow, row);
+                }
+        }
+}
+
 void executeJOIN()
 {
     logger.log("executeJOIN");
-    return;
-}
\ No newline at end of file
+    Table *table1 = tableCatalogue.getTable(parsedQuery.joinFirstRelationName);
+    Table *table2 = tableCatalogue.getTable(parsedQuery.joinSecondRelationName);
+
+    Table *resultantTable = new Table(parsedQuery.joinResultRelationName, getJoinedColumns(table1, table2));
+    JoinInput input1 = {table1, table1->getColumnIndex(parsedQuery.joinFirstColumnName), true};
+    JoinInput input2 = {table2, table2->getColumnIndex(parsedQuery.joinSecondColumnName), false};
+    vector<vector<int>> rows;
+    // an equi-join looks the rows of one input up in the index of the other
+    // if that reads fewer pages than joining the inputs whole
+    double indexJoinCost1 = canProbe(input2) ? getIndexJoinCost(input1, input2) : DBL_MAX;
+    double indexJoinCost2 = canProbe(input1) ? getIndexJoinCost(input2, input1) : DBL_MAX;
+    bool indexJoin = parsedQuery.joinBinaryOperator == EQUAL && min(indexJoinCost1, indexJoinCost2) < getHashJoinCost(input1, input2);
+
+    if (parsedQuery.joinBinaryOperator == NOT_EQUAL)
+        nestedLoopJoin(input1, input2, resultantTable, rows);
+    else if (indexJoin && indexJoinCost1 <= indexJoinCost2)
+        indexNestedLoopJoin(input1, input2, resultantTable, rows);
+    else if (indexJoin)
+        indexNestedLoopJoin(input2, input1, resultantTable, rows);
+    else
+    {
+        // inputs that are in order already are merged as they are; an
+        // equi-join is only merged if one of them is, and is a hash join
+        // otherwise
+        bool ordered1 = isIndexedOn(input1), ordered2 = isIndexedOn(input2);
+        bool sorted1 = !ordered1 && isSorted(input1), sorted2 = !ordered2 && isSorted(input2);
+        if (parsedQuery.joinBinaryOperator != EQUAL || ordered1 || ordered2 || sorted1 || sorted2)
+            sortMergeJoin(input1, input2, sorted1, sorted2, resultantTable, rows);
+        else
+            hashJoin(input1, input2, 0, parsedQuery.joinResultRelationName + "_temp_", resultantTable, rows);
+    }
+    writeRowsAsPage(resultantTable, rows);
+
+    if (resultantTable->rowCount)
+        tableCatalogue.insertTable(resultantTable);
+    else
+    {
+        cout << "Empty Table" << endl;
+        resultantTable->unload();
+        delete resultantTable;
+    }
+}
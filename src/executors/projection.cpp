@@ -51,7 +51,7 @@ void executePROJECTION()
 {
     logger.log("executePROJECTION");
     Table* resultantTable = new Table(parsedQuery.projectionResultRelationName, parsedQuery.projectionColumnList);
-    resultantTable->writeRow<string>(parsedQuery.projectionColumnList);
+    resultantTable->writeRow(parsedQuery.projectionColumnList);
     Table *table = tableCatalogue.getTable(parsedQuery.projectionRelationName);
     vector<int> columnIndices;
     for (int columnCounter = 0; columnCounter < parsedQuery.projectionColumnList.size(); columnCounter++)
@@ -59,34 +59,46 @@ void executePROJECTION()
         columnIndices.emplace_back(table->getColumnIndex(parsedQuery.projectionColumnList[columnCounter]));
     }
     
-    vector<int> row;
-    Cursor cursor;
-
-    if (!table->indexed)
-    {
-        cursor = table->getCursor();
-        row = cursor.getNext();
-    }
-    else if (table->indexingStrategy == HASH || table->indexingStrategy == BTREE)
+    // the rows of every morsel are put together on a worker thread, and
+    // appended to the source file of the resultant table in morsel order
+    ofstream fout(resultantTable->sourceFileName, ios::app);
+    ParallelScan scan(table);
+    scan.run<string>([&](ScanIterator &morsel, string &result)
     {
-        cursor = table->getCursor(0, 0);
-        row = cursor.getNextInAllBuckets();
-    }
-    
-    vector<int> resultantRow(columnIndices.size(), 0);
-
-    while (!row.empty())
-    {
-        for (int columnCounter = 0; columnCounter < columnIndices.size(); columnCounter++)
+        ostringstream out;
+        vector<int> resultantRow(columnIndices.size(), 0);
+        if (!table->indexed && table->layout == PAX_LAYOUT)
         {
-            resultantRow[columnCounter] = row[columnIndices[columnCounter]];
+            // only the projected columns are read, a page at a time
+            vector<span<const int>> columns;
+            int rowCount;
+            while ((rowCount = morsel.nextColumns(columnIndices, columns)))
+                for (int rowCounter = 0; rowCounter < rowCount; rowCounter++)
+                {
+                    for (int columnCounter = 0; columnCounter < columnIndices.size(); columnCounter++)
+                        resultantRow[columnCounter] = columns[columnCounter][rowCounter];
+                    resultantTable->writeRow(resultantRow, out);
+                }
         }
-        resultantTable->writeRow<int>(resultantRow);
-        if (!table->indexed)
-            row = cursor.getNext();
-        else if (table->indexingStrategy == HASH || table->indexingStrategy == BTREE)
-            row = cursor.getNextInAllBuckets();
-    }
+        else
+        {
+            RowBatch batch;
+            while (morsel.nextBatch(batch))
+                for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+                {
+                    span<const int> row = batch[rowCounter];
+                    for (int columnCounter = 0; columnCounter < columnIndices.size(); columnCounter++)
+                        resultantRow[columnCounter] = row[columnIndices[columnCounter]];
+                    resultantTable->writeRow(resultantRow, out);
+                }
+        }
+        result = out.str();
+    },
+    [&](string &result)
+    {
+        fout << result;
+    });
+    fout.close();
     resultantTable->blockify();
     tableCatalogue.insertTable(resultantTable);
     return;
@@ -103,20 +103,69 @@ bool evaluateBinOp(int value1, int value2, BinaryOperator binaryOperator)
     }
 }
 /**
- * @brief Checks the bucket for rows that satisfy the condition
+ * @brief Filter of the pages of table that may hold rows satisfying the
+ * condition: some value in the range of the first column compares true
+ * against the literal, or against some value in the range of the second
+ * column
+ * 
+ * @param table
+ * 
+ * @return PageFilter
+ */
+PageFilter selectionFilter(Table *table)
+{
+    int firstColumnIndex = table->getColumnIndex(parsedQuery.selectionFirstColumnName);
+    int secondColumnIndex = -1;
+    if (parsedQuery.selectType == COLUMN)
+        secondColumnIndex = table->getColumnIndex(parsedQuery.selectionSecondColumnName);
+    int literal = parsedQuery.selectionIntLiteral;
+    BinaryOperator binaryOperator = parsedQuery.selectionBinaryOperator;
+
+    return [=](const ZoneMap &zone) {
+        if (max(firstColumnIndex, secondColumnIndex) >= (int)zone.smallest.size())
+            return true;
+        int smallest = zone.smallest[firstColumnIndex], largest = zone.largest[firstColumnIndex];
+        int otherSmallest = literal, otherLargest = literal;
+        if (secondColumnIndex != -1)
+        {
+            otherSmallest = zone.smallest[secondColumnIndex];
+            otherLargest = zone.largest[secondColumnIndex];
+        }
+        switch (binaryOperator)
+        {
+        case LESS_THAN:
+            return smallest < otherLargest;
+        case GREATER_THAN:
+            return largest > otherSmallest;
+        case LEQ:
+            return smallest <= otherLargest;
+        case GEQ:
+            return largest >= otherSmallest;
+        case EQUAL:
+            return smallest <= otherLargest && otherSmallest <= largest;
+        case NOT_EQUAL:
+            return !(smallest == largest && otherSmallest == otherLargest && smallest == otherSmallest);
+        default:
+            return true;
+        }
+    };
+}
+
+/**
+ * @brief Checks the rows read by scan, e.g. the buckets found through the
+ * index, for rows that satisfy the condition, appending them to the result
  * 
  * @param table
  * 
  * @param resultantTable
  * 
- * @param bucket
+ * @param scan
  * 
  * @return 
  */
-void retrieveResult(Table *table, Table *resultantTable, int bucket)
+void retrieveResult(Table *table, Table *resultantTable, ScanIterator &scan)
 {
-    Cursor cursor = table->getCursor(bucket, 0);
-    vector<int> row = cursor.getNextInBucket();
+    span<const int> row = scan.next();
     vector<vector<int>> rows;
 
     while (!row.empty()) //loop to fill last page
@@ -128,21 +177,21 @@ void retrieveResult(Table *table, Table *resultantTable, int bucket)
         int value2 = parsedQuery.selectionIntLiteral;
         if (evaluateBinOp(value1, value2, parsedQuery.selectionBinaryOperator))
         {
-            rows.push_back(row);
+            rows.emplace_back(row.begin(), row.end());
             resultantTable->updateStatistics(row);
         }
         if (rows.size() == resultantTable->maxRowsPerBlock - resultantTable->rowsPerBlockCount[resultantTable->blockCount - 1])
         {
-            vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(resultantTable->tableName, resultantTable->blockCount - 1).data;
+            vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(resultantTable->tableName, resultantTable->blockCount - 1).getRows();
             // rowsInLastPage.resize(resultantTable->rowsPerBlockCount[resultantTable->blockCount - 1]);
             rowsInLastPage.insert(std::end(rowsInLastPage), std::begin(rows), std::end(rows));
             bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount - 1, rowsInLastPage, rowsInLastPage.size());
             resultantTable->rowsPerBlockCount[resultantTable->blockCount - 1] = resultantTable->maxRowsPerBlock;
             rows.clear();
-            row = cursor.getNextInBucket();
+            row = scan.next();
             break;
         }
-        row = cursor.getNextInBucket();
+        row = scan.next();
     }
 
     while (!row.empty())
@@ -151,7 +200,7 @@ void retrieveResult(Table *table, Table *resultantTable, int bucket)
         int value2 = parsedQuery.selectionIntLiteral;
         if (evaluateBinOp(value1, value2, parsedQuery.selectionBinaryOperator))
         {
-            rows.push_back(row);
+            rows.emplace_back(row.begin(), row.end());
             resultantTable->updateStatistics(row);
         }
         if (rows.size() == resultantTable->maxRowsPerBlock)
@@ -161,14 +210,14 @@ void retrieveResult(Table *table, Table *resultantTable, int bucket)
             resultantTable->blockCount++;
             rows.clear();
         }
-        row = cursor.getNextInBucket();
+        row = scan.next();
     }
 
     if (rows.size())
     {
         if (resultantTable->rowsPerBlockCount.size() && rows.size() <= resultantTable->maxRowsPerBlock - resultantTable->rowsPerBlockCount[resultantTable->blockCount - 1])
         {
-            vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(resultantTable->tableName, resultantTable->blockCount - 1).data;
+            vector<vector<int>> rowsInLastPage = bufferManager.getTablePage(resultantTable->tableName, resultantTable->blockCount - 1).getRows();
             // rowsInLastPage.resize(resultantTable->rowsPerBlockCount[resultantTable->blockCount - 1]);
             rowsInLastPage.insert(std::end(rowsInLastPage), std::begin(rows), std::end(rows));
             bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount - 1, rowsInLastPage, rowsInLastPage.size());
@@ -186,7 +235,9 @@ void retrieveResult(Table *table, Table *resultantTable, int bucket)
 }
 
 /**
- * @brief Saves the final result to tableCatalogue
+ * @brief Keeps the final result in tableCatalogue, or drops it if it is empty.
+ * The resultant table is catalogued before it is filled, because
+ * retrieveResult reads its pages back through the buffer manager.
  * 
  * @param resultantTable
  * 
@@ -194,307 +245,266 @@ void retrieveResult(Table *table, Table *resultantTable, int bucket)
  */
 void saveResult(Table *resultantTable)
 {
-    if (resultantTable->rowCount)
-        tableCatalogue.insertTable(resultantTable);
-    else{
+    if (!resultantTable->rowCount)
+    {
         cout<<"Empty Table"<<endl;
-        resultantTable->unload();
-        delete resultantTable;
+        tableCatalogue.deleteTable(resultantTable->tableName);
     }
 }
 
-void executeSELECTION()
+/**
+ * @brief Appends to matches the index of every value of values that satisfies
+ * the condition against the value at the same index of otherValues, or
+ * against literal if otherValues is empty
+ * 
+ * @param values
+ * 
+ * @param otherValues
+ * 
+ * @param literal
+ * 
+ * @param binaryOperator
+ * 
+ * @param matches
+ * 
+ * @return 
+ */
+void selectValues(span<const int> values, span<const int> otherValues, int literal, BinaryOperator binaryOperator, vector<int> &matches)
 {
+    auto select = [&](auto compare) {
+        if (otherValues.empty())
+        {
+            for (int index = 0; index < values.size(); index++)
+                if (compare(values[index], literal))
+                    matches.push_back(index);
+        }
+        else
+        {
+            for (int index = 0; index < values.size(); index++)
+                if (compare(values[index], otherValues[index]))
+                    matches.push_back(index);
+        }
+    };
+    switch (binaryOperator)
+    {
+    case LESS_THAN:
+        return select(less<int>());
+    case GREATER_THAN:
+        return select(greater<int>());
+    case LEQ:
+        return select(less_equal<int>());
+    case GEQ:
+        return select(greater_equal<int>());
+    case EQUAL:
+        return select(equal_to<int>());
+    case NOT_EQUAL:
+        return select(not_equal_to<int>());
+    default:
+        return;
+    }
+}
 
-    logger.log("executeSELECTION");
-    Table *table = tableCatalogue.getTable(parsedQuery.selectionRelationName);
-    Table *resultantTable = new Table(parsedQuery.selectionResultRelationName, table->columns);
+/**
+ * @brief Selects from the rows read by scan over an unindexed table stored in
+ * PAX layout. The condition is evaluated over the compared columns of a page
+ * at a time, and only the rows that satisfy it are put together.
+ * 
+ * @param table
+ * 
+ * @param scan
+ * 
+ * @param rows the rows that satisfy the condition are appended to it
+ * 
+ * @return 
+ */
+void selectColumns(Table *table, ScanIterator &scan, vector<vector<int>> &rows)
+{
+    logger.log("selectColumns");
+    vector<int> columnIndices(table->columnCount);
+    iota(columnIndices.begin(), columnIndices.end(), 0);
     int firstColumnIndex = table->getColumnIndex(parsedQuery.selectionFirstColumnName);
-    if (!table->indexed)
+    int secondColumnIndex = -1;
+    if (parsedQuery.selectType == COLUMN)
+        secondColumnIndex = table->getColumnIndex(parsedQuery.selectionSecondColumnName);
+
+    vector<span<const int>> columns;
+    vector<int> matches;
+    while (scan.nextColumns(columnIndices, columns))
     {
-        Cursor cursor = table->getCursor();
-        vector<int> row = cursor.getNext();
-        vector<vector<int>> rows;
-        int secondColumnIndex;
-        if (parsedQuery.selectType == COLUMN)
-            secondColumnIndex = table->getColumnIndex(parsedQuery.selectionSecondColumnName);
-        while (!row.empty())
+        matches.clear();
+        span<const int> otherValues = secondColumnIndex == -1 ? span<const int>() : columns[secondColumnIndex];
+        selectValues(columns[firstColumnIndex], otherValues, parsedQuery.selectionIntLiteral, parsedQuery.selectionBinaryOperator, matches);
+        for (int rowIndex : matches)
         {
-            int value1 = row[firstColumnIndex];
-            int value2;
-            if (parsedQuery.selectType == INT_LITERAL)
-                value2 = parsedQuery.selectionIntLiteral;
-            else
-                value2 = row[secondColumnIndex];
-            if (evaluateBinOp(value1, value2, parsedQuery.selectionBinaryOperator))
-            {
-                rows.push_back(row);
-                resultantTable->updateStatistics(row);
-            }
-            if (rows.size() == resultantTable->maxRowsPerBlock)
-            {
-                resultantTable->rowsPerBlockCount.emplace_back(rows.size());
-                bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
-                resultantTable->blockCount++;
-                rows.clear();
-            }
-
-            row = cursor.getNext();
+            vector<int> row(table->columnCount);
+            for (int columnCounter = 0; columnCounter < table->columnCount; columnCounter++)
+                row[columnCounter] = columns[columnCounter][rowIndex];
+            rows.push_back(row);
         }
+    }
+}
 
-        if (rows.size())
+/**
+ * @brief Selects from every row read by scan. Used when the index of the
+ * table, if any, cannot narrow down the rows to read.
+ * 
+ * @param table
+ * 
+ * @param scan
+ * 
+ * @param rows the rows that satisfy the condition are appended to it
+ * 
+ * @return 
+ */
+void selectRows(Table *table, ScanIterator &scan, vector<vector<int>> &rows)
+{
+    logger.log("selectRows");
+    int firstColumnIndex = table->getColumnIndex(parsedQuery.selectionFirstColumnName);
+    int secondColumnIndex;
+    if (parsedQuery.selectType == COLUMN)
+        secondColumnIndex = table->getColumnIndex(parsedQuery.selectionSecondColumnName);
+    span<const int> row = scan.next();
+    while (!row.empty())
+    {
+        int value1 = row[firstColumnIndex];
+        int value2;
+        if (parsedQuery.selectType == INT_LITERAL)
+            value2 = parsedQuery.selectionIntLiteral;
+        else
+            value2 = row[secondColumnIndex];
+        if (evaluateBinOp(value1, value2, parsedQuery.selectionBinaryOperator))
+            rows.emplace_back(row.begin(), row.end());
+        row = scan.next();
+    }
+}
+
+/**
+ * @brief Appends rows to the resultant table, writing a page whenever
+ * pageRows fills up. What is left in pageRows is written by the caller once
+ * every row has been appended.
+ * 
+ * @param resultantTable
+ * 
+ * @param rows
+ * 
+ * @param pageRows rows of the page being filled
+ * 
+ * @return 
+ */
+void appendRows(Table *resultantTable, vector<vector<int>> &rows, vector<vector<int>> &pageRows)
+{
+    for (vector<int> &row : rows)
+    {
+        resultantTable->updateStatistics(row);
+        pageRows.push_back(std::move(row));
+        if (pageRows.size() == resultantTable->maxRowsPerBlock)
         {
-            resultantTable->rowsPerBlockCount.emplace_back(rows.size());
-            bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
+            resultantTable->rowsPerBlockCount.emplace_back(pageRows.size());
+            bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, pageRows, pageRows.size());
             resultantTable->blockCount++;
-            rows.clear();
+            pageRows.clear();
         }
-        saveResult(resultantTable);
-        return;
     }
-    else if (table->indexingStrategy == HASH)
+}
+
+/**
+ * @brief Selects from every page of table that selectionFilter lets through.
+ * The morsels of the table are searched on the worker threads of a
+ * ParallelScan, and the rows found are written in morsel order, so the
+ * resultant table is the same as that of a serial scan.
+ * 
+ * @param table
+ * 
+ * @param resultantTable
+ * 
+ * @return 
+ */
+void selectInParallel(Table *table, Table *resultantTable)
+{
+    logger.log("selectInParallel");
+    bool columnar = !table->indexed && table->layout == PAX_LAYOUT;
+    vector<vector<int>> pageRows;
+    ParallelScan scan(table, selectionFilter(table));
+    scan.run<vector<vector<int>>>([&](ScanIterator &morsel, vector<vector<int>> &rows)
     {
-        if ((table->indexed && table->getIndexedColumn() != parsedQuery.selectionFirstColumnName) || (parsedQuery.selectType == COLUMN) || (parsedQuery.selectionBinaryOperator == NOT_EQUAL))
-        {
-            Cursor cursor = table->getCursor(0, 0);
-            vector<int> row = cursor.getNextInAllBuckets();
-            vector<vector<int>> rows;
-            int secondColumnIndex;
-            if (parsedQuery.selectType == COLUMN)
-                secondColumnIndex = table->getColumnIndex(parsedQuery.selectionSecondColumnName);
-            while (!row.empty())
-            {
-                int value1 = row[firstColumnIndex];
-                int value2;
-                if (parsedQuery.selectType == INT_LITERAL)
-                    value2 = parsedQuery.selectionIntLiteral;
-                else
-                    value2 = row[secondColumnIndex];
-                if (evaluateBinOp(value1, value2, parsedQuery.selectionBinaryOperator))
-                {
-                    rows.push_back(row);
-                    resultantTable->updateStatistics(row);
-                }
-                if (rows.size() == resultantTable->maxRowsPerBlock)
-                {
-                    resultantTable->rowsPerBlockCount.emplace_back(rows.size());
-                    bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
-                    resultantTable->blockCount++;
-                    rows.clear();
-                }
-                row = cursor.getNextInAllBuckets();
-            }
+        if (columnar)
+            selectColumns(table, morsel, rows);
+        else
+            selectRows(table, morsel, rows);
+    },
+    [&](vector<vector<int>> &rows)
+    {
+        appendRows(resultantTable, rows, pageRows);
+    });
 
-            if (rows.size())
-            {
-                resultantTable->rowsPerBlockCount.emplace_back(rows.size());
-                bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
-                resultantTable->blockCount++;
-                rows.clear();
-            }
-            saveResult(resultantTable);
-        }
-        else if (parsedQuery.selectionBinaryOperator == EQUAL)
-        {
-            retrieveResult(table, resultantTable, table->hash(parsedQuery.selectionIntLiteral));
-            saveResult(resultantTable);
-            return;
-        }
-        else if (parsedQuery.selectionBinaryOperator == LESS_THAN)
-        {
-            set<int> bucketsVisited;
-            for (int i = table->smallestInColumns[firstColumnIndex]; i < parsedQuery.selectionIntLiteral && bucketsVisited.size() != table->blocksInBuckets.size(); i++)
-            {
-                int bucket = table->hash(i);
-                if (bucketsVisited.find(bucket) == bucketsVisited.end())
-                {
-                    retrieveResult(table, resultantTable, bucket);
-                    bucketsVisited.insert(bucket);
-                }
-            }    
-    
-            saveResult(resultantTable);
-            return;
-        }
-        else if (parsedQuery.selectionBinaryOperator == LEQ)
-        {
-            set<int> bucketsVisited;
-            for (int i = table->smallestInColumns[firstColumnIndex]; i <= parsedQuery.selectionIntLiteral && bucketsVisited.size() != table->blocksInBuckets.size(); i++)
-            {
-                int bucket = table->hash(i);
-                if (bucketsVisited.find(bucket) == bucketsVisited.end())
-                {
-                    retrieveResult(table, resultantTable, bucket);
-                    bucketsVisited.insert(bucket);
-                }
-            }    
+    if (pageRows.size())
+    {
+        resultantTable->rowsPerBlockCount.emplace_back(pageRows.size());
+        bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, pageRows, pageRows.size());
+        resultantTable->blockCount++;
+        pageRows.clear();
+    }
+}
 
-            saveResult(resultantTable);
-            return;
-        }
-        else if (parsedQuery.selectionBinaryOperator == GREATER_THAN)
-        {
-            set<int> bucketsVisited;
-            for (int i = parsedQuery.selectionIntLiteral + 1; i < table->largestInColumns[firstColumnIndex] && bucketsVisited.size() != table->blocksInBuckets.size(); i++)
-            {
-                int bucket = table->hash(i);
-                if (bucketsVisited.find(bucket) == bucketsVisited.end())
-                {
-                    retrieveResult(table, resultantTable, bucket);
-                    bucketsVisited.insert(bucket);
-                }
-            }    
+void executeSELECTION()
+{
 
-            saveResult(resultantTable);
-            return;
-        }
-        else if (parsedQuery.selectionBinaryOperator == GEQ)
+    logger.log("executeSELECTION");
+    Table *table = tableCatalogue.getTable(parsedQuery.selectionRelationName);
+    Table *resultantTable = new Table(parsedQuery.selectionResultRelationName, table->columns);
+    tableCatalogue.insertTable(resultantTable);
+    int firstColumnIndex = table->getColumnIndex(parsedQuery.selectionFirstColumnName);
+    if (!table->indexed || table->getIndexedColumn() != parsedQuery.selectionFirstColumnName || parsedQuery.selectType == COLUMN || parsedQuery.selectionBinaryOperator == NOT_EQUAL)
+    {
+        selectInParallel(table, resultantTable);
+        saveResult(resultantTable);
+        return;
+    }
+
+    // the table is indexed on the compared column, so only the buckets that
+    // may hold the rows looked for are read
+    long long literal = parsedQuery.selectionIntLiteral;
+    ScanIterator scan;
+    if (table->indexingStrategy == HASH)
+    {
+        vector<int> buckets;
+        if (parsedQuery.selectionBinaryOperator == EQUAL)
+            buckets = table->getBucketsOf(literal);
+        else
         {
+            long long low = table->smallestInColumns[firstColumnIndex], high = table->largestInColumns[firstColumnIndex];
+            if (parsedQuery.selectionBinaryOperator == LESS_THAN)
+                high = literal - 1;
+            else if (parsedQuery.selectionBinaryOperator == LEQ)
+                high = literal;
+            else if (parsedQuery.selectionBinaryOperator == GREATER_THAN)
+                low = literal + 1;
+            else if (parsedQuery.selectionBinaryOperator == GEQ)
+                low = literal;
+
             set<int> bucketsVisited;
-            for (int i = parsedQuery.selectionIntLiteral + 1; i < table->largestInColumns[firstColumnIndex] && bucketsVisited.size() != table->blocksInBuckets.size(); i++)
+            for (long long i = low; i <= high && bucketsVisited.size() != table->blocksInBuckets.size(); i++)
             {
                 int bucket = table->hash(i);
-                if (bucketsVisited.find(bucket) == bucketsVisited.end())
-                {
-                    retrieveResult(table, resultantTable, bucket);
-                    bucketsVisited.insert(bucket);
-                }
-            }    
-
-            saveResult(resultantTable);
-            return;
+                if (bucketsVisited.insert(bucket).second)
+                    buckets.push_back(bucket);
+            }
         }
+        scan = IndexScan(table, buckets, nullptr, selectionFilter(table));
     }
     else if (table->indexingStrategy == BTREE)
     {
-        if ((table->indexed && table->getIndexedColumn() != parsedQuery.selectionFirstColumnName) || (parsedQuery.selectType == COLUMN) || (parsedQuery.selectionBinaryOperator == NOT_EQUAL))
-        {
-            Cursor cursor = table->getCursor(0, 0);
-            vector<int> row = cursor.getNextInAllBuckets();
-            vector<vector<int>> rows;
-            int secondColumnIndex;
-            if (parsedQuery.selectType == COLUMN)
-                secondColumnIndex = table->getColumnIndex(parsedQuery.selectionSecondColumnName);
-            while (!row.empty())
-            {
-                int value1 = row[firstColumnIndex];
-                int value2;
-                if (parsedQuery.selectType == INT_LITERAL)
-                    value2 = parsedQuery.selectionIntLiteral;
-                else
-                    value2 = row[secondColumnIndex];
-                if (evaluateBinOp(value1, value2, parsedQuery.selectionBinaryOperator))
-                {
-                    rows.push_back(row);
-                    resultantTable->updateStatistics(row);
-                }
-                if (rows.size() == resultantTable->maxRowsPerBlock)
-                {
-                    resultantTable->rowsPerBlockCount.emplace_back(rows.size());
-                    bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
-                    resultantTable->blockCount++;
-                    rows.clear();
-                }
-                row = cursor.getNextInAllBuckets();
-            }
-
-            if (rows.size())
-            {
-                resultantTable->rowsPerBlockCount.emplace_back(rows.size());
-                bufferManager.writeTablePage(resultantTable->tableName, resultantTable->blockCount, rows, rows.size());
-                resultantTable->blockCount++;
-                rows.clear();
-            }
-            saveResult(resultantTable);
-        }
-        else if (parsedQuery.selectionBinaryOperator == EQUAL)
-        {
-            auto record = table->bTree.find(parsedQuery.selectionIntLiteral, nullptr);
-            if (record == nullptr) 
-            {
-                saveResult(resultantTable);
-                return;
-            }
-            
-            int bucket_i = record->val();
-            int bucket_f = bucket_i;
-            while (bucket_f < table->blocksInBuckets.size())
-            {
-                if (table->bucketRanges[bucket_f].first <= parsedQuery.selectionIntLiteral)
-                    bucket_f++;
-                else
-                    break;
-            }
-
-            for (int bucket = bucket_f - 1; bucket >= bucket_i; bucket--) 
-                retrieveResult(table, resultantTable, bucket);
-            
-            saveResult(resultantTable);
-            return;
-        }
+        if (parsedQuery.selectionBinaryOperator == EQUAL)
+            scan = IndexScan(table, table->getBucketsOf(literal), nullptr, selectionFilter(table));
         else if (parsedQuery.selectionBinaryOperator == LESS_THAN)
-        {
-            for (int i = 0; i < table->blocksInBuckets.size(); i++)
-            {
-                if (table->blocksInBuckets[i].size())
-                {
-                    if (table->bucketRanges[i].first < parsedQuery.selectionIntLiteral)
-                        retrieveResult(table, resultantTable, i);
-                    else
-                        break;
-                }
-            }
-
-            saveResult(resultantTable);
-            return;
-        }
+            scan = OrderedIndexScan(table, INT_MIN, literal - 1, false, nullptr, selectionFilter(table));
         else if (parsedQuery.selectionBinaryOperator == LEQ)
-        {
-            for (int i = 0; i < table->blocksInBuckets.size(); i++)
-            {
-                if (table->blocksInBuckets[i].size())
-                {
-                    if (table->bucketRanges[i].first <= parsedQuery.selectionIntLiteral)
-                        retrieveResult(table, resultantTable, i);
-                    else
-                        break;
-                }
-            }   
-
-            saveResult(resultantTable);
-            return;
-        }
+            scan = OrderedIndexScan(table, INT_MIN, literal, false, nullptr, selectionFilter(table));
         else if (parsedQuery.selectionBinaryOperator == GREATER_THAN)
-        {
-            for (int i = table->blocksInBuckets.size() - 1; i >= 0; i--)
-            {
-                if (table->blocksInBuckets[i].size())
-                {
-                    if (table->bucketRanges[i].second > parsedQuery.selectionIntLiteral)
-                        retrieveResult(table, resultantTable, i);
-                    else
-                        break;
-                }
-            }
-
-            saveResult(resultantTable);
-            return;
-        }
+            scan = OrderedIndexScan(table, literal + 1, INT_MAX, true, nullptr, selectionFilter(table));
         else if (parsedQuery.selectionBinaryOperator == GEQ)
-        {
-            for (int i = table->blocksInBuckets.size() - 1; i >= 0; i--)
-            {
-                if (table->blocksInBuckets[i].size())
-                {
-                    if (table->bucketRanges[i].second >= parsedQuery.selectionIntLiteral)
-                        retrieveResult(table, resultantTable, i);
-                    else
-                        break;
-                }
-            } 
-
-            saveResult(resultantTable);
-            return;
-        }
+            scan = OrderedIndexScan(table, literal, INT_MAX, true, nullptr, selectionFilter(table));
     }
-}
\ No newline at end of file
+    retrieveResult(table, resultantTable, scan);
+    saveResult(resultantTable);
+}
@@ -0,0 +1,159 @@
+#include "global.h"
+
+#define MAX_READ_AHEAD 1024
+#define MAX_THREADS 256
+
+/**
+ * @brief 
+ * SYNTAX: SET parameter_name [relation_name] value
+ * parameter_name: BUFFER_POLICY (FIFO | LRU | CLOCK | 2Q)
+ *                 WRITE_BACK (ON | OFF)
+ *                 READ_AHEAD <pages> (at most MAX_READ_AHEAD)
+ *                 BUFFER_BYTES <bytes>
+ *                 QUOTA relation_name <bytes>
+ *                 MMAP relation_name (ON | OFF)
+ *                 LAYOUT relation_name (ROW | PAX)
+ *                 COMPRESSION relation_name (ON | OFF)
+ *                 THREADS <count> (0 for one per core, at most MAX_THREADS)
+ */
+bool syntacticParseSET()
+{
+    logger.log("syntacticParseSET");
+    if (tokenizedQuery.size() != 3 && tokenizedQuery.size() != 4)
+    {
+        cout << "SYNTAX ERROR" << endl;
+        return false;
+    }
+    parsedQuery.queryType = SET;
+    parsedQuery.setParameterName = tokenizedQuery[1];
+    parsedQuery.setParameterValue = tokenizedQuery.back();
+    if (tokenizedQuery.size() == 4)
+        parsedQuery.setRelationName = tokenizedQuery[2];
+    return true;
+}
+
+bool semanticParseSET()
+{
+    logger.log("semanticParseSET");
+    bool perRelation = parsedQuery.setParameterName == "QUOTA" || parsedQuery.setParameterName == "MMAP" || parsedQuery.setParameterName == "LAYOUT" || parsedQuery.setParameterName == "COMPRESSION";
+    if (perRelation != !parsedQuery.setRelationName.empty())
+    {
+        cout << "SEMANTIC ERROR: " << parsedQuery.setParameterName << (perRelation ? " needs" : " does not take") << " a relation name" << endl;
+        return false;
+    }
+    if (perRelation && !tableCatalogue.isTable(parsedQuery.setRelationName) && !matrixCatalogue.isMatrix(parsedQuery.setRelationName))
+    {
+        cout << "SEMANTIC ERROR: Relation doesn't exist" << endl;
+        return false;
+    }
+    if (parsedQuery.setParameterName == "BUFFER_POLICY")
+    {
+        string policy = parsedQuery.setParameterValue;
+        if (policy != "FIFO" && policy != "LRU" && policy != "CLOCK" && policy != "2Q")
+        {
+            cout << "SEMANTIC ERROR: Unknown buffer policy" << endl;
+            return false;
+        }
+        return true;
+    }
+    if (parsedQuery.setParameterName == "WRITE_BACK" || parsedQuery.setParameterName == "MMAP" || parsedQuery.setParameterName == "COMPRESSION")
+    {
+        if (parsedQuery.setParameterValue != "ON" && parsedQuery.setParameterValue != "OFF")
+        {
+            cout << "SEMANTIC ERROR: " << parsedQuery.setParameterName << " must be ON or OFF" << endl;
+            return false;
+        }
+        if (parsedQuery.setParameterName == "MMAP" && !tableCatalogue.isTable(parsedQuery.setRelationName))
+        {
+            cout << "SEMANTIC ERROR: Only tables can be memory mapped" << endl;
+            return false;
+        }
+        if (parsedQuery.setParameterName == "COMPRESSION" && !tableCatalogue.isTable(parsedQuery.setRelationName))
+        {
+            cout << "SEMANTIC ERROR: Only tables can be compressed" << endl;
+            return false;
+        }
+        return true;
+    }
+    if (parsedQuery.setParameterName == "LAYOUT")
+    {
+        if (parsedQuery.setParameterValue != "ROW" && parsedQuery.setParameterValue != "PAX")
+        {
+            cout << "SEMANTIC ERROR: LAYOUT must be ROW or PAX" << endl;
+            return false;
+        }
+        if (!tableCatalogue.isTable(parsedQuery.setRelationName))
+        {
+            cout << "SEMANTIC ERROR: Only tables have a layout" << endl;
+            return false;
+        }
+        return true;
+    }
+    if (parsedQuery.setParameterName == "READ_AHEAD" || parsedQuery.setParameterName == "BUFFER_BYTES" || parsedQuery.setParameterName == "QUOTA" || parsedQuery.setParameterName == "THREADS")
+    {
+        regex numeric("[0-9]+");
+        if (!regex_match(parsedQuery.setParameterValue, numeric))
+        {
+            cout << "SEMANTIC ERROR: " << parsedQuery.setParameterName << " must be a non-negative number" << endl;
+            return false;
+        }
+        unsigned long long value;
+        try
+        {
+            value = stoull(parsedQuery.setParameterValue);
+        }
+        catch (out_of_range& e)
+        {
+            cout << "SEMANTIC ERROR: " << parsedQuery.setParameterName << " is out of range" << endl;
+            return false;
+        }
+        unsigned long long limit = numeric_limits<size_t>::max();
+        if (parsedQuery.setParameterName == "READ_AHEAD")
+            limit = MAX_READ_AHEAD;
+        else if (parsedQuery.setParameterName == "THREADS")
+            limit = MAX_THREADS;
+        if (value > limit)
+        {
+            cout << "SEMANTIC ERROR: " << parsedQuery.setParameterName << " must be at most " << limit << endl;
+            return false;
+        }
+        return true;
+    }
+    cout << "SEMANTIC ERROR: Unknown parameter" << endl;
+    return false;
+}
+
+void executeSET()
+{
+    logger.log("executeSET");
+    if (parsedQuery.setParameterName == "BUFFER_POLICY")
+    {
+        string policy = parsedQuery.setParameterValue;
+        if (policy == "LRU")
+            REPLACEMENT_STRATEGY = LRU;
+        else if (policy == "CLOCK")
+            REPLACEMENT_STRATEGY = CLOCK;
+        else if (policy == "2Q")
+            REPLACEMENT_STRATEGY = TWO_Q;
+        else
+            REPLACEMENT_STRATEGY = FIFO;
+        bufferManager.setReplacementStrategy(REPLACEMENT_STRATEGY);
+    }
+    else if (parsedQuery.setParameterName == "WRITE_BACK")
+        bufferManager.setWriteBack(parsedQuery.setParameterValue == "ON");
+    else if (parsedQuery.setParameterName == "READ_AHEAD")
+        bufferManager.setReadAhead(stoi(parsedQuery.setParameterValue));
+    else if (parsedQuery.setParameterName == "BUFFER_BYTES")
+        bufferManager.setByteBudget(stoull(parsedQuery.setParameterValue));
+    else if (parsedQuery.setParameterName == "QUOTA")
+        bufferManager.setQuota(parsedQuery.setRelationName, stoull(parsedQuery.setParameterValue));
+    else if (parsedQuery.setParameterName == "MMAP")
+        bufferManager.setMapped(parsedQuery.setRelationName, parsedQuery.setParameterValue == "ON");
+    else if (parsedQuery.setParameterName == "LAYOUT")
+        tableCatalogue.getTable(parsedQuery.setRelationName)->setLayout(parsedQuery.setParameterValue == "PAX" ? PAX_LAYOUT : ROW_LAYOUT);
+    else if (parsedQuery.setParameterName == "COMPRESSION")
+        tableCatalogue.getTable(parsedQuery.setRelationName)->setCompressed(parsedQuery.setParameterValue == "ON");
+    else if (parsedQuery.setParameterName == "THREADS")
+        THREAD_COUNT = stoi(parsedQuery.setParameterValue);
+    return;
+}
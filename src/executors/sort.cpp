@@ -65,25 +65,14 @@ void executeSORT()
     resultantTable->maxRowsPerBlock = table->maxRowsPerBlock;
     resultantTable->rowCount = table->rowCount;
     resultantTable->rowsPerBlockCount.resize(table->blockCount * 3, 0);
+    // sorted output delta encodes well
+    resultantTable->compressed = table->compressed;
     tableCatalogue.insertTable(resultantTable);
 
     int runSize = table->maxRowsPerBlock * parsedQuery.sortBufferSize;
     int columnIndex = table->getColumnIndex(parsedQuery.sortColumnName);
 
-    vector<int> row;
-    Cursor cursor;
-
-    if (!table->indexed)
-    {
-        cursor = table->getCursor();
-        row = cursor.getNext();
-    }
-    else if (table->indexingStrategy == HASH || ((table->indexingStrategy == BTREE && table->indexedColumn != columnIndex)))
-    {
-        cursor = table->getCursor(0, 0);
-        row = cursor.getNextInAllBuckets();
-    }
-    else if (table->indexingStrategy == BTREE && table->indexedColumn == columnIndex)
+    if (table->indexingStrategy == BTREE && table->indexedColumn == columnIndex)
     {
         Table *table = tableCatalogue.getTable(parsedQuery.sortRelationName);
         
@@ -92,13 +81,13 @@ void executeSORT()
             {
                 Table *tempTable = new Table(parsedQuery.sortResultRelationName + "_temp_" + to_string(i), table->columns);
                 tableCatalogue.insertTable(tempTable);
-                Cursor cursor = table->getCursor(i, 0);
-                vector<int> row = cursor.getNextInBucket();
+                ScanIterator scan = IndexScan(table, {i}, nullptr, nullptr);
+                span<const int> row = scan.next();
                 vector<vector<int>> rows;
 
                 while (!row.empty())
                 {
-                    rows.push_back(row);
+                    rows.emplace_back(row.begin(), row.end());
                     tempTable->updateStatistics(row);
 
                     if (rows.size() == tempTable->maxRowsPerBlock)
@@ -108,7 +97,7 @@ void executeSORT()
                         tempTable->blockCount++;
                         rows.clear();
                     }
-                    row = cursor.getNextInBucket();
+                    row = scan.next();
                 }
 
                 if (rows.size())
@@ -125,7 +114,7 @@ void executeSORT()
         resultantTable->blockCount = 0;
         resultantTable->rowsPerBlockCount.clear();
 
-        vector<int>row;
+        span<const int> row;
         vector<vector<int>> rows;
         
 
@@ -133,11 +122,12 @@ void executeSORT()
             if (table->blocksInBuckets[i].size())
             {
                 Table *tempTable = tableCatalogue.getTable(parsedQuery.sortResultRelationName + "_temp_" + to_string(i));
-                Cursor cursor = tempTable->getCursor(0, 0);
-                row = cursor.getNextInAllBuckets();
+                // the sorted runs of the bucket are stored as hash pages
+                ScanIterator scan = BucketScan(tempTable, nullptr, nullptr);
+                row = scan.next();
                 while (!row.empty())
                 {
-                    rows.push_back(row);
+                    rows.emplace_back(row.begin(), row.end());
                     if (rows.size() == resultantTable->maxRowsPerBlock)
                     {
                         resultantTable->rowsPerBlockCount.emplace_back(rows.size());
@@ -145,12 +135,10 @@ void executeSORT()
                         resultantTable->blockCount++;
                         rows.clear();
                     }
-                    row = cursor.getNextInAllBuckets();
+                    row = scan.next();
                 }
 
-                for (int i = 0; i < tempTable->blocksInBuckets.size(); i++)
-                    for (int j = 0; j < tempTable->blocksInBuckets[i].size(); j++)
-                        bufferManager.deleteHashFile(tempTable->tableName, i, j);
+                bufferManager.deleteSegment(tempTable->tableName, HASH_PAGE);
                 tableCatalogue.deleteTable(tempTable->tableName);
             }
 
@@ -163,7 +151,12 @@ void executeSORT()
         }
         return;
     }
-    
+
+    // runs are read a page of rows at a time
+    ScanIterator scan = table->getScan();
+    RowBatch batch;
+    scan.nextBatch(batch);
+    int batchPointer = 0;
 
     int runsCount = 0;
     int zerothPassRunsCount;
@@ -171,17 +164,20 @@ void executeSORT()
     int originalBlockCount = table->blockCount;
     int blocksWritten = 0;
 
-    while (!row.empty())
+    while (batchPointer < batch.rowCount)
     {
         vector<vector<int>> rows;
+        rows.reserve(runSize);
         int rowsRead = 0;
-        while (!row.empty() && rowsRead != runSize)
+        while (batchPointer < batch.rowCount && rowsRead != runSize)
         {
-            rows.push_back(row);
-            if (!table->indexed)
-                row = cursor.getNext();
-            else if (table->indexingStrategy == HASH || ((table->indexingStrategy == BTREE && table->indexedColumn != columnIndex)))
-                row = cursor.getNextInAllBuckets();
+            span<const int> row = batch[batchPointer];
+            rows.emplace_back(row.begin(), row.end());
+            if (++batchPointer == batch.rowCount)
+            {
+                scan.nextBatch(batch);
+                batchPointer = 0;
+            }
 
             rowsRead++;
         }
@@ -233,34 +229,35 @@ void executeSORT()
             unordered_map<int, int> pagesReadInRun;
             int minSize = min(runsCount - runsRead, parsedQuery.sortBufferSize - 1);
 
-            vector<vector<vector<int>>> dataFromPages(minSize);
+            // the heap holds rows in place in the pages being merged
+            vector<TablePage> dataFromPages(minSize);
             vector<int> rowsReadFromPages(minSize, 0);
 
-            auto comp = [&](const pair<vector<int>, int> &a, const pair<vector<int>, int> &b) {
+            auto comp = [&](const pair<span<const int>, int> &a, const pair<span<const int>, int> &b) {
                 if (parsedQuery.sortingStrategy == ASC)
                     return a.first[columnIndex] > b.first[columnIndex];
                 else if (parsedQuery.sortingStrategy == DESC)
                     return a.first[columnIndex] < b.first[columnIndex];
             };
 
-            priority_queue<pair<vector<int>, int>, vector<pair<vector<int>, int>>, function<bool(const pair<vector<int>, int> &a, const pair<vector<int>, int> &b)>> heap(comp);
+            priority_queue<pair<span<const int>, int>, vector<pair<span<const int>, int>>, function<bool(const pair<span<const int>, int> &a, const pair<span<const int>, int> &b)>> heap(comp);
 
             for (int i = 0; i < minSize; i++)
             {
                 int runPageIndex = (passCount & 1 ? 2 * originalBlockCount : originalBlockCount);
 
                 runPageIndex += ((runsRead + i) * pagesInRun[passCount * zerothPassRunsCount] + pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + i)]++);
-                dataFromPages[i] = (bufferManager.getTablePage(resultantTable->tableName, runPageIndex).data);
+                dataFromPages[i] = bufferManager.getTablePage(resultantTable->tableName, runPageIndex);
                 // dataFromPages[i].resize(resultantTable->rowsPerBlockCount[runPageIndex]);
-                heap.push(make_pair(dataFromPages[i][rowsReadFromPages[i]++], i));
+                heap.push(make_pair(dataFromPages[i].getRow(rowsReadFromPages[i]++), i));
             }
             vector<vector<int>> rows;
             while (!heap.empty())
             {
-                pair<vector<int>, int> temp = heap.top();
+                pair<span<const int>, int> temp = heap.top();
                 heap.pop();
 
-                rows.push_back(temp.first);
+                rows.emplace_back(temp.first.begin(), temp.first.end());
                 if (rows.size() == resultantTable->maxRowsPerBlock)
                 {
                     int runPageIndex = (passCount & 1 ? originalBlockCount : 2 * originalBlockCount);
@@ -286,17 +283,17 @@ void executeSORT()
 
                 runPageIndex += ((runsRead + temp.second) * pagesInRun[passCount * zerothPassRunsCount] + pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)] - 1);
                 if (rowsReadFromPages[temp.second] != resultantTable->rowsPerBlockCount[runPageIndex])
-                    heap.push(make_pair(dataFromPages[temp.second][rowsReadFromPages[temp.second]++], temp.second));
+                    heap.push(make_pair(dataFromPages[temp.second].getRow(rowsReadFromPages[temp.second]++), temp.second));
                 else //all rows exhausted
                 {
                     if (pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)] != pagesInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)]) // all pages not exhausted
                     {
                         int runPageIndex = (passCount & 1 ? 2 * originalBlockCount : originalBlockCount);
                         runPageIndex += ((runsRead + temp.second) * pagesInRun[passCount * zerothPassRunsCount] + pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)]++);
-                        dataFromPages[temp.second] = bufferManager.getTablePage(resultantTable->tableName, runPageIndex).data;
+                        dataFromPages[temp.second] = bufferManager.getTablePage(resultantTable->tableName, runPageIndex);
                         // dataFromPages[temp.second].resize(resultantTable->rowsPerBlockCount[runPageIndex]);
                         rowsReadFromPages[temp.second] = 0;
-                        heap.push(make_pair(dataFromPages[temp.second][rowsReadFromPages[temp.second]++], temp.second));
+                        heap.push(make_pair(dataFromPages[temp.second].getRow(rowsReadFromPages[temp.second]++), temp.second));
                     }
                 }
             }
@@ -334,7 +331,10 @@ void executeSORT()
         // if (totalPasses == 0)
         //     bufferManager.writeTablePage(resultantTable->tableName, finalBlocksWritten++, bufferManager.getTablePage(resultantTable->tableName, i).data, bufferManager.getTablePage(resultantTable->tableName, i).data.size());
         if (totalPasses == 0)
-            bufferManager.writeTablePage(resultantTable->tableName, finalBlocksWritten++, bufferManager.getTablePage(resultantTable->tableName, i).data, resultantTable->rowsPerBlockCount[i]);
+        {
+            resultantTable->rowsPerBlockCount[finalBlocksWritten] = resultantTable->rowsPerBlockCount[i];
+            bufferManager.writeTablePage(resultantTable->tableName, finalBlocksWritten++, bufferManager.getTablePage(resultantTable->tableName, i).getRows(), resultantTable->rowsPerBlockCount[i]);
+        }
         bufferManager.deleteTableFile(resultantTable->tableName, i);
     }
 
@@ -7,12 +7,14 @@
 extern float BLOCK_SIZE;
 extern uint BLOCK_COUNT;
 extern uint PRINT_COUNT;
+extern uint THREAD_COUNT;
 extern vector<string> tokenizedQuery;
 extern ParsedQuery parsedQuery;
 extern TableCatalogue tableCatalogue;
 extern MatrixCatalogue matrixCatalogue;
 extern BufferManager bufferManager;
 extern int MATRIX_PAGE_DIM;
+extern ReplacementStrategy REPLACEMENT_STRATEGY;
 
 #define MOD(a, m) ((((a) % (m)) + (m)) % (m))
 
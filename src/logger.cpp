@@ -1,11 +1,89 @@
 #include "global.h"
 
-Logger::Logger()
+Logger::Logger() : ring(LOG_RING_SIZE)
 {
     this->fout.open(this->logFile, ios::out);
+    for (size_t position = 0; position < this->ring.size(); position++)
+        this->ring[position].sequence.store(position, memory_order_relaxed);
+    this->writer = thread(&Logger::drain, this);
 }
 
-void Logger::log(string logString)
+/**
+ * @brief Writes out the lines still in the ring and stops the writer.
+ *
+ */
+Logger::~Logger()
 {
-    fout << logString << endl;
+    this->stopping.store(true, memory_order_release);
+    this->writer.join();
+    this->fout.close();
+}
+
+/**
+ * @brief Adds line to the ring. Threads claim the next position with a
+ * compare and swap, and the slot at it is handed to the writer once the line
+ * is in, so threads logging at the same time never wait on each other.
+ *
+ * @param line
+ */
+void Logger::push(string line)
+{
+    size_t mask = this->ring.size() - 1;
+    size_t position = this->head.load(memory_order_relaxed);
+    Slot* slot;
+    while (true) {
+        slot = &this->ring[position & mask];
+        size_t sequence = slot->sequence.load(memory_order_acquire);
+        if (sequence == position) {
+            if (this->head.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+                break;
+        } else if (sequence < position) {
+            // the ring is full
+            this_thread::yield();
+            position = this->head.load(memory_order_relaxed);
+        } else
+            position = this->head.load(memory_order_relaxed);
+    }
+    slot->line = std::move(line);
+    slot->sequence.store(position + 1, memory_order_release);
+}
+
+/**
+ * @brief Takes the oldest line out of the ring. Only the writer calls this.
+ *
+ * @param line
+ * @return true if there was a line to take
+ */
+bool Logger::pop(string& line)
+{
+    Slot& slot = this->ring[this->tail & (this->ring.size() - 1)];
+    if (slot.sequence.load(memory_order_acquire) != this->tail + 1)
+        return false;
+    line = std::move(slot.line);
+    slot.sequence.store(this->tail + this->ring.size(), memory_order_release);
+    this->tail++;
+    return true;
+}
+
+/**
+ * @brief Body of the writer thread: writes lines as they come, flushing the
+ * file whenever the ring runs empty, until the logger is destroyed.
+ *
+ */
+void Logger::drain()
+{
+    string line;
+    while (true) {
+        // read before the ring, so that no line logged before the logger was
+        // destroyed is left behind
+        bool stopping = this->stopping.load(memory_order_acquire);
+        if (this->pop(line)) {
+            this->fout << line << '\n';
+            continue;
+        }
+        this->fout.flush();
+        if (stopping)
+            return;
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
 }
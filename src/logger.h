@@ -4,22 +4,90 @@
 #include<iostream>
 #include<bits/stdc++.h>
 #include<variant>
-#include<sys/stat.h> 
+#include<sys/stat.h>
 #include<fstream>
 
 using namespace std;
 
+enum LogLevel {
+    LOG_TRACE,      // every function called, e.g. "Cursor::getNext"
+    LOG_DEBUG,
+    LOG_INFO,       // the commands read
+    LOG_WARNING,
+    LOG_ERROR,      // pages and files that could not be read or written
+    LOG_OFF
+};
+
+// calls below this level are compiled out, e.g. make LOG_LEVEL=LOG_TRACE logs
+// every function called
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_INFO
+#endif
+
+// lines that can wait for the log writer, a power of two
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 4096
+#endif
+
+/**
+ * @brief Writes lines to the file "log". A call logs the parts given one after
+ * the other, e.g. logger.error("cannot open ", fileName), and is compiled out
+ * if its level is below LOG_LEVEL, so the parts are then never put together.
+ *
+ * <p>
+ * Lines that are logged are put in a lock-free ring buffer, which any thread
+ * can add to, and written out by a background thread, which flushes the file
+ * whenever the ring runs empty. A thread finding the ring full waits for the
+ * writer to make room rather than dropping its line.
+ *
+ */
 class Logger{
 
+    struct Slot {
+        // the position the slot is written at next, one past it once it holds
+        // a line to write
+        atomic<size_t> sequence;
+        string line;
+    };
+
     string logFile = "log";
     ofstream fout;
-    
+    vector<Slot> ring;
+    atomic<size_t> head = 0;
+    size_t tail = 0;
+    atomic<bool> stopping = false;
+    thread writer;
+
+    void push(string line);
+    bool pop(string& line);
+    void drain();
+
+    template <LogLevel level, typename... Parts>
+    void write(const Parts&... parts) {
+        if constexpr (level >= LOG_LEVEL) {
+            ostringstream line;
+            (line << ... << parts);
+            this->push(line.str());
+        }
+    }
+
     public:
 
     Logger();
-    void log(string logString);
+    ~Logger();
+
+    template <typename... Parts>
+    void log(const Parts&... parts) { this->write<LOG_TRACE>(parts...); }
+    template <typename... Parts>
+    void debug(const Parts&... parts) { this->write<LOG_DEBUG>(parts...); }
+    template <typename... Parts>
+    void info(const Parts&... parts) { this->write<LOG_INFO>(parts...); }
+    template <typename... Parts>
+    void warning(const Parts&... parts) { this->write<LOG_WARNING>(parts...); }
+    template <typename... Parts>
+    void error(const Parts&... parts) { this->write<LOG_ERROR>(parts...); }
 };
 
 extern Logger logger;
 
-#endif
\ No newline at end of file
+#endif
@@ -118,7 +118,6 @@ void Matrix::makePermanent() {
 
     ofstream fout(this->sourceFileName, ios::trunc);
 
-    vector<vector<int>> this_page; // avoid multiple constructor and destructor calls
     for (long long int i = 0; i < this->dimension;) {
 
         long long int j = 0;
@@ -136,7 +135,8 @@ void Matrix::makePermanent() {
 
         int block_j = 0;
         for (; block_j < this->blockCount - 1; block_j++) {
-            this_page = bufferManager.getMatrixPage(this->matrixName, block_i, block_j).getMatrix();
+            auto page = bufferManager.pinMatrixPage(this->matrixName, block_i, block_j);
+            const vector<vector<int>>& this_page = page->getMatrix();
             
             for (int k = 0; k < can_go_upto; k++) {
                 lines[k].insert(lines[k].end(), this_page[line_in_block + k].begin(), this_page[line_in_block + k].end());
@@ -145,7 +145,8 @@ void Matrix::makePermanent() {
             j = j + MATRIX_PAGE_DIM;
         }
 
-        this_page = bufferManager.getMatrixPage(this->matrixName, block_i, block_j).getMatrix();
+        auto page = bufferManager.pinMatrixPage(this->matrixName, block_i, block_j);
+        const vector<vector<int>>& this_page = page->getMatrix();
         for (int k = 0; k < can_go_upto; k++) {
             lines[k].insert(lines[k].end(), this_page[line_in_block + k].begin(), this_page[line_in_block + k].begin() + (this->dimension - j));
         }
@@ -173,11 +174,11 @@ void Matrix::transpose()
     {
         for (int colIndex = rowIndex + 1; colIndex < this->blockCount; colIndex++)
         {
-            MatrixPage currentPage = bufferManager.getMatrixPage(this->matrixName, rowIndex, colIndex);
-            vector<vector<int>> currentMatrix = currentPage.getMatrix();
+            auto currentPage = bufferManager.pinMatrixPage(this->matrixName, rowIndex, colIndex);
+            vector<vector<int>>& currentMatrix = currentPage.mutate().getMatrix();
 
-            MatrixPage swapPage = bufferManager.getMatrixPage(this->matrixName, colIndex, rowIndex);
-            vector<vector<int>> swapMatrix = swapPage.getMatrix();
+            auto swapPage = bufferManager.pinMatrixPage(this->matrixName, colIndex, rowIndex);
+            vector<vector<int>>& swapMatrix = swapPage.mutate().getMatrix();
 
             // transposing inside the matrices
             for (int i = 0; i < MATRIX_PAGE_DIM; i++)
@@ -187,30 +188,25 @@ void Matrix::transpose()
                     swap(swapMatrix[i][j], swapMatrix[j][i]);
                 }
 
-            bufferManager.writeMatrixPage(this->matrixName, rowIndex, colIndex, swapMatrix);
-            bufferManager.writeMatrixPage(this->matrixName, colIndex, rowIndex, currentMatrix);
+            // the pages trade contents in place
+            currentMatrix.swap(swapMatrix);
         }
     }
 
     // for blocks on diagonal
     for (int rowIndex = 0; rowIndex < this->blockCount; rowIndex++)
     {
-        MatrixPage currentPage = bufferManager.getMatrixPage(this->matrixName, rowIndex, rowIndex);
-        vector<vector<int>> currentMatrix = currentPage.getMatrix();
+        auto currentPage = bufferManager.pinMatrixPage(this->matrixName, rowIndex, rowIndex);
+        vector<vector<int>>& currentMatrix = currentPage.mutate().getMatrix();
         
         // transposing inside the matrix
         for (int i = 0; i < MATRIX_PAGE_DIM; i++)
             for (int j = i + 1; j < MATRIX_PAGE_DIM; j++)
                 swap(currentMatrix[i][j], currentMatrix[j][i]);
-        
-        bufferManager.writeMatrixPage(this->matrixName, rowIndex, rowIndex, currentMatrix);
     }
 }
 
 void Matrix::unload() {
-    for (long long int i = 0; i < this->blockCount; i++) {
-        for (long long int j = 0; j < this->blockCount; j++) {
-            bufferManager.deleteMatrixFile(this->matrixName, i, j);
-        }
-    }
+    bufferManager.deleteSegment(this->matrixName, MATRIX_PAGE);
+    bufferManager.forgetRelation(this->matrixName);
 }
\ No newline at end of file
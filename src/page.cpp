@@ -1,4 +1,424 @@
 #include "global.h"
+
+static unordered_map<string, int> relationIds;
+// a deque, so that names handed out stay put as more are added
+static deque<string> relationNames;
+// taken as the worker threads of a ParallelScan look ids up too
+static mutex relationIdsLock;
+
+/**
+ * @brief Returns the id standing for relationName in page ids, assigning a new
+ * one the first time the name is seen. Ids are never reused.
+ *
+ * @param relationName 
+ * @return int 
+ */
+int getRelationId(const string& relationName) {
+    lock_guard<mutex> guard(relationIdsLock);
+    auto it = relationIds.find(relationName);
+    if (it != relationIds.end())
+        return it->second;
+    relationNames.push_back(relationName);
+    return relationIds[relationName] = relationNames.size() - 1;
+}
+
+const string& getRelationName(int relationId) {
+    lock_guard<mutex> guard(relationIdsLock);
+    return relationNames[relationId];
+}
+
+bool PageId::operator==(const PageId& other) const {
+    return this->relation == other.relation && this->kind == other.kind && this->x == other.x && this->y == other.y;
+}
+
+/**
+ * @brief Id standing for the whole segment the page belongs to, i.e. all pages
+ * of the same kind of the same relation
+ *
+ * @return PageId 
+ */
+PageId PageId::segment() const {
+    return PageId(this->relation, this->kind, -1, -1);
+}
+
+size_t PageIdHash::operator()(const PageId& id) const {
+    size_t hash = id.relation;
+    hash = hash * 4 + id.kind;
+    hash = hash * 1000003 + id.x;
+    hash = hash * 1000003 + id.y;
+    return hash;
+}
+/**
+ * @brief Converts between host byte order and the little-endian order of page
+ * files. The same call converts both ways.
+ *
+ * @param value 
+ * @return int32_t 
+ */
+static int32_t littleEndian(int32_t value) {
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return __builtin_bswap32(value);
+#else
+    return value;
+#endif
+}
+
+/**
+ * @brief Calls visit(row, column) for every value of a page of rowCount rows
+ * of columnCount values, in the order the values are stored in under layout.
+ *
+ * @param layout 
+ * @param rowCount 
+ * @param columnCount 
+ * @param visit 
+ */
+template <typename Visit>
+static void forEachValue(PageLayout layout, int rowCount, int columnCount, Visit visit) {
+    if (layout == PAX_LAYOUT) {
+        for (int columnCounter = 0; columnCounter < columnCount; columnCounter++)
+            for (int rowCounter = 0; rowCounter < rowCount; rowCounter++)
+                visit(rowCounter, columnCounter);
+    } else {
+        for (int rowCounter = 0; rowCounter < rowCount; rowCounter++)
+            for (int columnCounter = 0; columnCounter < columnCount; columnCounter++)
+                visit(rowCounter, columnCounter);
+    }
+}
+
+/**
+ * @brief Encodings of the columns of a compressed page. Each column is stored
+ * as its encoding followed by:
+ *  PLAIN_ENCODING      the values
+ *  FRAME_OF_REFERENCE  the smallest value, a bit width, and every value minus
+ *                      the smallest packed into that many bits
+ *  DELTA_ENCODING      the first value, then the differences between
+ *                      consecutive values as a frame of reference
+ *  RUN_LENGTH          the number of runs, then a value and a length per run
+ *
+ */
+enum ColumnEncoding {
+    PLAIN_ENCODING,
+    FRAME_OF_REFERENCE,
+    DELTA_ENCODING,
+    RUN_LENGTH
+};
+
+/**
+ * @brief Number of bits needed to store every value up to range
+ *
+ * @param range 
+ * @return int 
+ */
+static int bitWidth(uint64_t range) {
+    int width = 0;
+    while (width < 64 && (range >> width))
+        width++;
+    return width;
+}
+
+static size_t packedLength(size_t count, int width) {
+    return (count * width + 31) / 32;
+}
+
+/**
+ * @brief Appends offsets, each packed into width bits, to words
+ *
+ * @param offsets 
+ * @param width at most 32
+ * @param words 
+ */
+static void packBits(const vector<uint32_t>& offsets, int width, vector<int32_t>& words) {
+    uint64_t pending = 0;
+    int pendingBits = 0;
+    for (uint32_t offset : offsets) {
+        pending |= (uint64_t)offset << pendingBits;
+        pendingBits += width;
+        if (pendingBits >= 32) {
+            words.push_back(littleEndian((uint32_t)pending));
+            pending >>= 32;
+            pendingBits -= 32;
+        }
+    }
+    if (pendingBits > 0)
+        words.push_back(littleEndian((uint32_t)pending));
+}
+
+/**
+ * @brief Unpacks count offsets of width bits from words
+ *
+ * @param words 
+ * @param count 
+ * @param width at most 32
+ * @param offsets 
+ */
+static void unpackBits(const int32_t* words, size_t count, int width, vector<uint32_t>& offsets) {
+    offsets.resize(count);
+    uint64_t mask = width == 32 ? 0xffffffffULL : (1ULL << width) - 1;
+    uint64_t pending = 0;
+    int pendingBits = 0;
+    for (size_t index = 0; index < count; index++) {
+        if (pendingBits < width) {
+            pending |= (uint64_t)(uint32_t)littleEndian(*words++) << pendingBits;
+            pendingBits += 32;
+        }
+        offsets[index] = pending & mask;
+        pending >>= width;
+        pendingBits -= width;
+    }
+}
+
+/**
+ * @brief Appends column to words in whichever encoding takes the fewest
+ * words: sorted columns end up delta encoded, columns with few distinct
+ * values run length encoded, and columns of values close to each other
+ * packed as a frame of reference.
+ *
+ * @param column 
+ * @param words 
+ */
+static void encodeColumn(const vector<int32_t>& column, vector<int32_t>& words) {
+    size_t count = column.size();
+    ColumnEncoding encoding = PLAIN_ENCODING;
+    size_t length = count;
+
+    int64_t smallest = count ? *min_element(column.begin(), column.end()) : 0;
+    int64_t largest = count ? *max_element(column.begin(), column.end()) : 0;
+    int width = bitWidth(largest - smallest);
+    if (width <= 32 && 2 + packedLength(count, width) < length) {
+        encoding = FRAME_OF_REFERENCE;
+        length = 2 + packedLength(count, width);
+    }
+
+    int64_t smallestDelta = 0, largestDelta = 0;
+    for (size_t index = 1; index < count; index++) {
+        int64_t delta = (int64_t)column[index] - column[index - 1];
+        smallestDelta = index == 1 ? delta : min(smallestDelta, delta);
+        largestDelta = index == 1 ? delta : max(largestDelta, delta);
+    }
+    int deltaWidth = bitWidth(largestDelta - smallestDelta);
+    if (count > 1 && deltaWidth <= 32 && 3 + packedLength(count - 1, deltaWidth) < length) {
+        encoding = DELTA_ENCODING;
+        length = 3 + packedLength(count - 1, deltaWidth);
+    }
+
+    size_t runCount = 0;
+    for (size_t index = 0; index < count; index++)
+        if (index == 0 || column[index] != column[index - 1])
+            runCount++;
+    if (1 + 2 * runCount < length)
+        encoding = RUN_LENGTH;
+
+    words.push_back(littleEndian(encoding));
+    vector<uint32_t> offsets;
+    switch (encoding) {
+        case FRAME_OF_REFERENCE:
+            words.push_back(littleEndian((int32_t)smallest));
+            words.push_back(littleEndian(width));
+            for (int32_t value : column)
+                offsets.push_back(value - smallest);
+            packBits(offsets, width, words);
+            break;
+        case DELTA_ENCODING:
+            words.push_back(littleEndian(column[0]));
+            words.push_back(littleEndian((int32_t)smallestDelta));
+            words.push_back(littleEndian(deltaWidth));
+            for (size_t index = 1; index < count; index++)
+                offsets.push_back((int64_t)column[index] - column[index - 1] - smallestDelta);
+            packBits(offsets, deltaWidth, words);
+            break;
+        case RUN_LENGTH:
+            words.push_back(littleEndian((int32_t)runCount));
+            for (size_t index = 0, runLength; index < count; index += runLength) {
+                for (runLength = 1; index + runLength < count && column[index + runLength] == column[index]; runLength++)
+                    ;
+                words.push_back(littleEndian(column[index]));
+                words.push_back(littleEndian((int32_t)runLength));
+            }
+            break;
+        default:
+            for (int32_t value : column)
+                words.push_back(littleEndian(value));
+    }
+}
+
+/**
+ * @brief Decodes a column of count values starting at words
+ *
+ * @param words 
+ * @param end end of the page
+ * @param count 
+ * @param column 
+ * @return const int32_t* first word after the column, nullptr if the column
+ * is damaged
+ */
+static const int32_t* decodeColumn(const int32_t* words, const int32_t* end, size_t count, vector<int32_t>& column) {
+    column.resize(count);
+    vector<uint32_t> offsets;
+    if (words >= end)
+        return nullptr;
+    switch (littleEndian(*words++)) {
+        case PLAIN_ENCODING:
+            if ((size_t)(end - words) < count)
+                return nullptr;
+            for (size_t index = 0; index < count; index++)
+                column[index] = littleEndian(*words++);
+            return words;
+        case FRAME_OF_REFERENCE: {
+            if (end - words < 2)
+                return nullptr;
+            int64_t smallest = littleEndian(words[0]);
+            int width = littleEndian(words[1]);
+            words += 2;
+            if (width < 0 || width > 32 || (size_t)(end - words) < packedLength(count, width))
+                return nullptr;
+            unpackBits(words, count, width, offsets);
+            for (size_t index = 0; index < count; index++)
+                column[index] = smallest + offsets[index];
+            return words + packedLength(count, width);
+        }
+        case DELTA_ENCODING: {
+            if (count == 0 || end - words < 3)
+                return nullptr;
+            int64_t value = littleEndian(words[0]);
+            int64_t smallestDelta = littleEndian(words[1]);
+            int width = littleEndian(words[2]);
+            words += 3;
+            if (width < 0 || width > 32 || (size_t)(end - words) < packedLength(count - 1, width))
+                return nullptr;
+            unpackBits(words, count - 1, width, offsets);
+            column[0] = value;
+            for (size_t index = 1; index < count; index++)
+                column[index] = value += smallestDelta + offsets[index - 1];
+            return words + packedLength(count - 1, width);
+        }
+        case RUN_LENGTH: {
+            size_t runCount = (uint32_t)littleEndian(*words++);
+            if (runCount > (size_t)(end - words) / 2)
+                return nullptr;
+            size_t index = 0;
+            for (size_t run = 0; run < runCount; run++, words += 2) {
+                size_t runLength = littleEndian(words[1]);
+                if (index + runLength > count)
+                    return nullptr;
+                fill_n(column.begin() + index, runLength, littleEndian(words[0]));
+                index += runLength;
+            }
+            return index == count ? words : nullptr;
+        }
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * @brief Reads rowCount rows of columnCount values of page id from its segment.
+ * value(row, column) gives the place to store each value in, so that both flat
+ * pages and matrix blocks can be read. A binary page is read with a single
+ * pread, and decoded if it was compressed; its header must match the expected
+ * shape and layout.
+ *
+ * @param id 
+ * @param layout order the values are stored in
+ * @param rowCount 
+ * @param columnCount 
+ * @param value 
+ */
+template <typename Value>
+static void readPageData(const PageId& id, PageLayout layout, int rowCount, int columnCount, Value value) {
+#ifdef TEXT_PAGES
+    string text(segmentStore.size(id), ' ');
+    segmentStore.read(id, text.data(), text.size());
+    istringstream fin(text);
+    forEachValue(layout, rowCount, columnCount, [&](int row, int column) { fin >> value(row, column); });
+#else
+    size_t headerLength = sizeof(PageHeader) / sizeof(int32_t);
+    size_t plainLength = headerLength + (size_t)rowCount * columnCount;
+    size_t bytes = segmentStore.size(id);
+    vector<int32_t> buffer(max(plainLength, bytes / sizeof(int32_t)));
+
+    ssize_t readBytes = segmentStore.read(id, buffer.data(), bytes);
+    PageHeader header;
+    memcpy(&header, buffer.data(), sizeof(PageHeader));
+    bool encoded = littleEndian(header.encoded);
+    if (readBytes != (ssize_t)bytes || (!encoded && bytes != plainLength * sizeof(int32_t)) ||
+        littleEndian(header.version) != PAGE_FORMAT_VERSION || littleEndian(header.rowCount) != rowCount ||
+        littleEndian(header.columnCount) != columnCount || littleEndian(header.layout) != layout) {
+        logger.error("readPageData: bad page of ", getRelationName(id.relation));
+        return;
+    }
+
+    const int32_t* stored = buffer.data() + headerLength;
+    if (!encoded) {
+        forEachValue(layout, rowCount, columnCount, [&](int row, int column) { value(row, column) = littleEndian(*stored++); });
+        return;
+    }
+    const int32_t* end = buffer.data() + bytes / sizeof(int32_t);
+    vector<int32_t> values;
+    for (int columnCounter = 0; columnCounter < columnCount; columnCounter++) {
+        stored = decodeColumn(stored, end, rowCount, values);
+        if (!stored) {
+            logger.error("readPageData: bad column in page of ", getRelationName(id.relation));
+            return;
+        }
+        for (int rowCounter = 0; rowCounter < rowCount; rowCounter++)
+            value(rowCounter, columnCounter) = values[rowCounter];
+    }
+#endif
+}
+
+/**
+ * @brief Writes rowCount rows of columnCount values, given by value(row,
+ * column), as the contents of page id in its segment. A binary page is written
+ * with a single pwrite. If compress is set, each column is encoded on its own
+ * (see ColumnEncoding), unless that does not make the page any smaller.
+ *
+ * @param id 
+ * @param layout order to store the values in
+ * @param rowCount 
+ * @param columnCount 
+ * @param value 
+ * @param compress 
+ */
+template <typename Value>
+static void writePageData(const PageId& id, PageLayout layout, int rowCount, int columnCount, Value value, bool compress = false) {
+#ifdef TEXT_PAGES
+    // one line per row, or per column of a PAX page
+    ostringstream fout;
+    int lineLength = layout == PAX_LAYOUT ? rowCount : columnCount;
+    int valueCount = 0;
+    forEachValue(layout, rowCount, columnCount, [&](int row, int column) {
+        fout << value(row, column) << (++valueCount % lineLength ? " " : "\n");
+    });
+    string text = fout.str();
+    bool written = segmentStore.write(id, text.data(), text.size());
+#else
+    PageHeader header = {littleEndian(PAGE_FORMAT_VERSION), littleEndian(rowCount), littleEndian(columnCount), littleEndian(layout), 0};
+    size_t headerLength = sizeof(PageHeader) / sizeof(int32_t);
+    size_t plainLength = headerLength + (size_t)rowCount * columnCount;
+    vector<int32_t> buffer(headerLength);
+
+    if (compress) {
+        vector<int32_t> values(rowCount);
+        for (int columnCounter = 0; columnCounter < columnCount && buffer.size() < plainLength; columnCounter++) {
+            for (int rowCounter = 0; rowCounter < rowCount; rowCounter++)
+                values[rowCounter] = value(rowCounter, columnCounter);
+            encodeColumn(values, buffer);
+        }
+        header.encoded = littleEndian(buffer.size() < plainLength);
+    }
+    if (!header.encoded) {
+        buffer.resize(plainLength);
+        int32_t* stored = buffer.data() + headerLength;
+        forEachValue(layout, rowCount, columnCount, [&](int row, int column) { *stored++ = littleEndian(value(row, column)); });
+    }
+    memcpy(buffer.data(), &header, sizeof(PageHeader));
+
+    bool written = segmentStore.write(id, buffer.data(), buffer.size() * sizeof(int32_t));
+#endif
+    if (!written)
+        logger.error("writePageData: cannot write page of ", getRelationName(id.relation));
+}
+
 /**
  * @brief Construct a new Page object. Never used as part of the code
  *
@@ -13,82 +433,384 @@ Page::Page() {
     this->data.clear();
 }
 
+TablePage::TablePage() {
+    logger.log("TablePage::TablePage");
+}
+
 /**
  * @brief Construct a new Page:: Page object given the table name and page
  * index. When tables are loaded they are broken up into blocks of BLOCK_SIZE
  * and each block is stored in a different file named
  * "<tablename>_Page<pageindex>". For example, If the Page being loaded is of
  * table "R" and the pageIndex is 2 then the file name is "R_Page2". The page
- * loads the rows (or tuples) into a vector of rows (where each row is a vector
- * of integers).
+ * loads the rows (or tuples) into one contiguous buffer of integers, in the
+ * layout of the table.
  *
  * @param tableName 
  * @param pageIndex 
  */
-TablePage::TablePage(string tableName, int pageIndex) {
+TablePage::TablePage(string tableName, int pageIndex) : TablePage(PageId(getRelationId(tableName), TABLE_PAGE, pageIndex)) {
+}
+
+/**
+ * @brief Reads table page id, as the buffer manager does on a miss. The table
+ * is looked up by the relation id, without hashing its name.
+ *
+ * @param id 
+ */
+TablePage::TablePage(const PageId& id) {
     logger.log("TablePage::TablePage");
-    this->tableName = tableName;
-    this->pageIndex = pageIndex;
-    this->pageName = TABLE_PAGE_NAME(tableName, pageIndex);
-    Table *table = tableCatalogue.getTable(tableName);
+    this->id = id;
+    this->tableName = getRelationName(id.relation);
+    this->pageIndex = id.x;
+    this->pageName = TABLE_PAGE_NAME(this->tableName, id.x);
+    Table *table = tableCatalogue.getTable(id.relation);
     this->columnCount = table->columnCount;
-    uint maxRowCount = table->maxRowsPerBlock;
-    this->rowCount = table->rowsPerBlockCount[pageIndex];
-    vector<int> row(columnCount, 0);
-    this->data.assign(this->rowCount, row);
-    ifstream fin(pageName, ios::in);
-    int number;
-    for (uint rowCounter = 0; rowCounter < this->rowCount; rowCounter++) {
-        for (int columnCounter = 0; columnCounter < columnCount; columnCounter++) {
-            fin >> number;
-            this->data[rowCounter][columnCounter] = number;
-        }
+    this->rowCount = table->rowsPerBlockCount[id.x];
+    this->layout = table->layout;
+    this->compressed = table->compressed;
+    this->data.assign((size_t)this->rowCount * this->columnCount, 0);
+    this->readRows();
+}
+
+/**
+ * @brief Position of value (row, column) in the data of a page of rowCount
+ * rows of columnCount values stored in layout
+ *
+ * @return size_t 
+ */
+static size_t valueIndex(PageLayout layout, int rowCount, int columnCount, int row, int column) {
+    if (layout == PAX_LAYOUT)
+        return (size_t)column * rowCount + row;
+    return (size_t)row * columnCount + column;
+}
+
+/**
+ * @brief Rows rowIndex onwards of a page of rowCount rows of columnCount
+ * values stored under layout, one row after the other: in place for
+ * ROW_LAYOUT, gathered into buffer otherwise.
+ *
+ * @param values 
+ * @param layout 
+ * @param rowCount 
+ * @param columnCount 
+ * @param rowIndex 
+ * @param buffer 
+ * @return span<const int> empty if there is no such row
+ */
+static span<const int> rowsFrom(const int* values, PageLayout layout, int rowCount, int columnCount, int rowIndex, vector<int>& buffer) {
+    if (rowIndex >= rowCount)
+        return span<const int>();
+    size_t length = (size_t)(rowCount - rowIndex) * columnCount;
+    if (layout == ROW_LAYOUT)
+        return span<const int>(values + (size_t)rowIndex * columnCount, length);
+    buffer.resize(length);
+    for (int columnCounter = 0; columnCounter < columnCount; columnCounter++) {
+        const int* column = values + (size_t)columnCounter * rowCount;
+        for (int rowCounter = rowIndex; rowCounter < rowCount; rowCounter++)
+            buffer[(size_t)(rowCounter - rowIndex) * columnCount + columnCounter] = column[rowCounter];
     }
-    fin.close();
+    return buffer;
+}
+
+/**
+ * @brief Reads the rows of the page from its segment into data, which must
+ * already hold rowCount rows.
+ * 
+ */
+void Page::readRows() {
+    int* values = this->data.data();
+    PageLayout layout = this->layout;
+    int rowCount = this->rowCount, columnCount = this->columnCount;
+    readPageData(this->id, layout, rowCount, columnCount, [=](int row, int column) -> int& { return values[valueIndex(layout, rowCount, columnCount, row, column)]; });
+}
+
+/**
+ * @brief Get row from page indexed by rowIndex. The row points into the page
+ * and is only valid as long as the page is neither changed nor released. Rows
+ * of PAX pages are gathered into a buffer of the page and are only valid
+ * until the next call, so pages shared through the pool should be read with
+ * a buffer of the reader's own instead.
+ * 
+ * @param rowIndex 
+ * @return span<const int> empty if there is no such row
+ */
+span<const int> Page::getRow(int rowIndex) const {
+    return this->getRow(rowIndex, this->rowBuffer);
 }
 
 /**
- * @brief Get row from page indexed by rowIndex
+ * @brief Get row from page indexed by rowIndex, gathering it into buffer if
+ * the page is not stored row after row.
  * 
  * @param rowIndex 
- * @return vector<int> 
+ * @param buffer 
+ * @return span<const int> empty if there is no such row
  */
-vector<int> Page::getRow(int rowIndex) {
-    logger.log("Page::getRow");
-    vector<int> result;
-    result.clear();
+span<const int> Page::getRow(int rowIndex, vector<int>& buffer) const {
     if (rowIndex >= this->rowCount)
-        return result;
-    return this->data[rowIndex];
+        return span<const int>();
+    if (this->layout == ROW_LAYOUT)
+        return span<const int>(this->data.data() + (size_t)rowIndex * this->columnCount, this->columnCount);
+    buffer.resize(this->columnCount);
+    for (int columnCounter = 0; columnCounter < this->columnCount; columnCounter++)
+        buffer[columnCounter] = this->data[(size_t)columnCounter * this->rowCount + rowIndex];
+    return buffer;
 }
 
+/**
+ * @brief Get all the values of column columnIndex of a PAX page as one array
+ * 
+ * @param columnIndex 
+ * @return span<const int> empty if the page is not a PAX page
+ */
+span<const int> Page::getColumn(int columnIndex) const {
+    if (this->layout != PAX_LAYOUT || columnIndex >= this->columnCount)
+        return span<const int>();
+    return span<const int>(this->data.data() + (size_t)columnIndex * this->rowCount, this->rowCount);
+}
+
+/**
+ * @brief Copies the rows of the page out as separate rows
+ * 
+ * @return vector<vector<int>> 
+ */
+vector<vector<int>> Page::getRows() const {
+    vector<vector<int>> rows;
+    rows.reserve(this->rowCount);
+    vector<int> buffer;
+    for (int rowCounter = 0; rowCounter < this->rowCount; rowCounter++) {
+        span<const int> row = this->getRow(rowCounter, buffer);
+        rows.emplace_back(row.begin(), row.end());
+    }
+    return rows;
+}
+
+/**
+ * @brief Get the rows of the page from rowIndex on, one after the other,
+ * gathering them into buffer if the page is not stored row after row.
+ * 
+ * @param rowIndex 
+ * @param buffer 
+ * @return span<const int> empty if there is no such row
+ */
+span<const int> Page::getRows(int rowIndex, vector<int>& buffer) const {
+    return rowsFrom(this->data.data(), this->layout, this->rowCount, this->columnCount, rowIndex, buffer);
+}
+
+int Page::getRowCount() const {
+    return this->rowCount;
+}
+
+int Page::getColumnCount() const {
+    return this->columnCount;
+}
+
+PageLayout Page::getLayout() const {
+    return this->layout;
+}
+
+/**
+ * @brief Rearranges the values of the page to be stored in layout
+ * 
+ * @param layout 
+ */
+void Page::setLayout(PageLayout layout) {
+    logger.log("Page::setLayout");
+    if (layout == this->layout)
+        return;
+    vector<int> values(this->data.size());
+    for (int rowCounter = 0; rowCounter < this->rowCount; rowCounter++)
+        for (int columnCounter = 0; columnCounter < this->columnCount; columnCounter++)
+            values[valueIndex(layout, this->rowCount, this->columnCount, rowCounter, columnCounter)] =
+                this->data[valueIndex(this->layout, this->rowCount, this->columnCount, rowCounter, columnCounter)];
+    this->data.swap(values);
+    this->layout = layout;
+}
+
+/**
+ * @brief Sets whether the page is compressed the next time it is written
+ * 
+ * @param compressed 
+ */
+void Page::setCompressed(bool compressed) {
+    this->compressed = compressed;
+}
+
+/**
+ * @brief Checks if the page holds a row equal to row
+ * 
+ * @param row 
+ * @return true if found
+ */
+bool Page::hasRow(span<const int> row) const {
+    logger.log("Page::hasRow");
+    vector<int> buffer;
+    for (int rowCounter = 0; rowCounter < this->rowCount; rowCounter++)
+        if (ranges::equal(this->getRow(rowCounter, buffer), row))
+            return true;
+    return false;
+}
+
+/**
+ * @brief Smallest and largest value of each column of the page. Columns of an
+ * empty page have no values, so their range is empty.
+ * 
+ * @return ZoneMap 
+ */
+ZoneMap Page::getZoneMap() const {
+    ZoneMap zone;
+    zone.smallest.assign(this->columnCount, INT_MAX);
+    zone.largest.assign(this->columnCount, INT_MIN);
+    const int* value = this->data.data();
+    forEachValue(this->layout, this->rowCount, this->columnCount, [&](int row, int column) {
+        zone.smallest[column] = min(zone.smallest[column], *value);
+        zone.largest[column] = max(zone.largest[column], *value);
+        value++;
+    });
+    return zone;
+}
+
+/**
+ * @brief Checks if every value of row lies within the range of its column,
+ * i.e. if the page may hold row.
+ * 
+ * @param row 
+ * @return true if the page may hold row
+ */
+bool ZoneMap::contains(span<const int> row) const {
+    if (row.size() != this->smallest.size())
+        return false;
+    for (int columnCounter = 0; columnCounter < row.size(); columnCounter++)
+        if (row[columnCounter] < this->smallest[columnCounter] || row[columnCounter] > this->largest[columnCounter])
+            return false;
+    return true;
+}
+
+/**
+ * @brief Adds row at the end of the page. Does not check if the page is full.
+ * 
+ * @param row 
+ */
+void Page::appendRow(span<const int> row) {
+    logger.log("Page::appendRow");
+    this->columnCount = row.size();
+    this->data.resize((size_t)this->rowCount * this->columnCount);
+    if (this->layout == ROW_LAYOUT) {
+        this->data.insert(this->data.end(), row.begin(), row.end());
+        this->rowCount++;
+        return;
+    }
+    // every column grows by one value, so later columns move up
+    this->data.resize((size_t)(this->rowCount + 1) * this->columnCount);
+    for (int columnCounter = this->columnCount - 1; columnCounter >= 0; columnCounter--) {
+        auto column = this->data.begin() + (size_t)columnCounter * this->rowCount;
+        auto movedColumn = this->data.begin() + (size_t)columnCounter * (this->rowCount + 1);
+        copy_backward(column, column + this->rowCount, movedColumn + this->rowCount);
+        movedColumn[this->rowCount] = row[columnCounter];
+    }
+    this->rowCount++;
+}
+
+/**
+ * @brief Removes all rows equal to row from the page
+ * 
+ * @param row 
+ * @return int number of rows removed
+ */
+int Page::removeRow(span<const int> row) {
+    logger.log("Page::removeRow");
+    vector<int> buffer;
+    vector<int> keptRows;
+    for (int rowCounter = 0; rowCounter < this->rowCount; rowCounter++)
+        if (!ranges::equal(this->getRow(rowCounter, buffer), row))
+            keptRows.push_back(rowCounter);
+
+    // moving values in the order they are stored never overwrites one that
+    // is still to be moved
+    int keptCount = keptRows.size();
+    forEachValue(this->layout, keptCount, this->columnCount, [&](int keptCounter, int columnCounter) {
+        this->data[valueIndex(this->layout, keptCount, this->columnCount, keptCounter, columnCounter)] =
+            this->data[valueIndex(this->layout, this->rowCount, this->columnCount, keptRows[keptCounter], columnCounter)];
+    });
+
+    int removedCount = this->rowCount - keptCount;
+    this->rowCount = keptCount;
+    this->data.resize((size_t)this->rowCount * this->columnCount);
+    return removedCount;
+}
+
+/**
+ * @brief Memory taken by a grid of rows, including the row vectors themselves
+ * 
+ * @param rows 
+ * @return size_t 
+ */
+static size_t rowsFootprint(const vector<vector<int>>& rows) {
+    size_t bytes = rows.capacity() * sizeof(vector<int>);
+    for (auto& row : rows)
+        bytes += row.capacity() * sizeof(int);
+    return bytes;
+}
+
+/**
+ * @brief Approximate memory taken by the page, used by the buffer manager to
+ * account for the pool's memory
+ * 
+ * @return size_t bytes
+ */
+size_t Page::footprint() const {
+    return sizeof(Pages) + this->pageName.capacity() + this->tableName.capacity() + (this->data.capacity() + this->rowBuffer.capacity()) * sizeof(int);
+}
+
+/**
+ * @brief Construct a new page of rows of table tableName, to be stored in the
+ * layout of the table, and compressed if the table is. Pages written for a
+ * table that is not in the catalogue (yet) are stored row after row, without
+ * compression.
+ * 
+ * @param tableName 
+ * @param pageIndex 
+ * @param rows 
+ * @param rowCount 
+ */
 TablePage::TablePage(string tableName, int pageIndex, vector<vector<int>> rows, int rowCount) {
     logger.log("Page::Page");
     this->tableName = tableName;
     this->pageIndex = pageIndex;
     this->rowCount = rowCount;
-    rows.resize(this->rowCount);
-    this->data = rows;
-    this->columnCount = rows[0].size();    
+    this->columnCount = rows[0].size();
+    this->id = PageId(getRelationId(this->tableName), TABLE_PAGE, pageIndex);
+    if (Table *table = tableCatalogue.getTable(this->id.relation)) {
+        this->layout = table->layout;
+        this->compressed = table->compressed;
+    }
+    this->setRows(rows);
     this->pageName = TABLE_PAGE_NAME(this->tableName, pageIndex);
 }
 
+/**
+ * @brief Copies the first rowCount rows of rows into data
+ * 
+ * @param rows 
+ */
+void Page::setRows(const vector<vector<int>>& rows) {
+    this->data.resize((size_t)this->rowCount * this->columnCount);
+    forEachValue(this->layout, this->rowCount, this->columnCount, [&](int row, int column) {
+        this->data[valueIndex(this->layout, this->rowCount, this->columnCount, row, column)] = rows[row][column];
+    });
+}
+
 /**
  * @brief writes current page contents to file.
  * 
  */
 void Page::writePage() {
     logger.log("Page::writePage");
-    ofstream fout(this->pageName, ios::trunc);
-    for (int rowCounter = 0; rowCounter < this->rowCount; rowCounter++) {
-        for (int columnCounter = 0; columnCounter < this->columnCount; columnCounter++) {
-            if (columnCounter != 0)
-                fout << " ";
-            fout << this->data[rowCounter][columnCounter];
-        }
-        fout << endl;
-    }
-    fout.close();
+    const int* values = this->data.data();
+    PageLayout layout = this->layout;
+    int rowCount = this->rowCount, columnCount = this->columnCount;
+    writePageData(this->id, layout, rowCount, columnCount, [=](int row, int column) { return values[valueIndex(layout, rowCount, columnCount, row, column)]; }, this->compressed);
 }
 
 MatrixPage::MatrixPage(const string& matrixName, int rowIndex, int colIndex) {
@@ -98,18 +820,13 @@ MatrixPage::MatrixPage(const string& matrixName, int rowIndex, int colIndex) {
     this->rowIndex = rowIndex;
     this->colIndex = colIndex;
     this->pageName = MATRIX_PAGE_NAME(this->matrixName, this->rowIndex, this->colIndex);
+    this->id = PageId(getRelationId(this->matrixName), MATRIX_PAGE, this->rowIndex, this->colIndex);
 
     this->matrix.resize(MATRIX_PAGE_DIM);
     fill(this->matrix.begin(), this->matrix.end(), vector<int>(MATRIX_PAGE_DIM, -1));
 
-    ifstream fin(this->pageName, ios::in);
-    for (int i = 0; i < MATRIX_PAGE_DIM; i++) {
-        for (int j = 0; j < MATRIX_PAGE_DIM; j++) {
-            int temp;
-            fin >> temp;
-            this->matrix[i][j] = temp;  // -1's are also filled
-        }
-    }
+    // -1's are also filled
+    readPageData(this->id, ROW_LAYOUT, MATRIX_PAGE_DIM, MATRIX_PAGE_DIM, [this](int row, int column) -> int& { return this->matrix[row][column]; });
 }
 
 MatrixPage::MatrixPage(const string& matrixName, int rowIndex, int colIndex, const vector<vector<int>>& data) {
@@ -119,55 +836,56 @@ MatrixPage::MatrixPage(const string& matrixName, int rowIndex, int colIndex, con
     this->rowIndex = rowIndex;
     this->colIndex = colIndex;
     this->pageName = MATRIX_PAGE_NAME(this->matrixName, this->rowIndex, this->colIndex);
+    this->id = PageId(getRelationId(this->matrixName), MATRIX_PAGE, this->rowIndex, this->colIndex);
 
     this->matrix = data;
 }
 
-vector<vector<int>> MatrixPage::getMatrix() {
+const vector<vector<int>>& MatrixPage::getMatrix() const {
+    logger.log("MatrixPage::getMatrix");
+
+    return this->matrix;
+}
+
+vector<vector<int>>& MatrixPage::getMatrix() {
     logger.log("MatrixPage::getMatrix");
 
     return this->matrix;
 }
 
+size_t MatrixPage::footprint() const {
+    return Page::footprint() + this->matrixName.capacity() + rowsFootprint(this->matrix);
+}
+
 bool MatrixPage::writePage() {
     logger.log("MatrixPage::writePage");
 
-    ofstream fout(this->pageName, ios::trunc);
-    for (int i = 0; i < MATRIX_PAGE_DIM; i++) {
-        for (int j = 0; j < MATRIX_PAGE_DIM; j++) {
-            fout << this->matrix[i][j];
-            if (j != MATRIX_PAGE_DIM - 1) {
-                fout << " ";
-            }
-        }
-        fout << endl;
-    }
-    fout.close();
+    writePageData(this->id, ROW_LAYOUT, MATRIX_PAGE_DIM, MATRIX_PAGE_DIM, [this](int row, int column) { return this->matrix[row][column]; });
     return true;
 }
 
-HashPage::HashPage(const string& tableName, int bucket, int chainCount) {
+HashPage::HashPage(const string& tableName, int bucket, int chainCount) : HashPage(PageId(getRelationId(tableName), HASH_PAGE, bucket, chainCount)) {
+}
+
+/**
+ * @brief Reads hash page id, i.e. page id.y of the chain of bucket id.x. The
+ * table is looked up by the relation id, without hashing its name.
+ *
+ * @param id 
+ */
+HashPage::HashPage(const PageId& id) {
     logger.log("HashPage::HashPage");
-    this->tableName = tableName;
-    this->bucket = bucket;
-    this->chainCount = chainCount;
+    this->id = id;
+    this->tableName = getRelationName(id.relation);
+    this->bucket = id.x;
+    this->chainCount = id.y;
     this->pageName = HASH_PAGE_NAME(this->tableName, this->bucket, this->chainCount);
-    Table *table = tableCatalogue.getTable(tableName);
+    Table *table = tableCatalogue.getTable(id.relation);
     this->columnCount = table->columnCount;
-    uint maxRowCount = table->maxRowsPerBlock;
-    vector<int> row(columnCount, 0);
-    this->rowCount = table->blocksInBuckets[bucket][chainCount];
-    this->data.assign(this->rowCount, row);
-
-    ifstream fin(pageName, ios::in);
-    int number;
-    for (uint rowCounter = 0; rowCounter < this->rowCount; rowCounter++) {
-        for (int columnCounter = 0; columnCounter < this->columnCount; columnCounter++) {
-            fin >> number;
-            this->data[rowCounter][columnCounter] = number;
-        }
-    }
-    fin.close();
+    this->compressed = table->compressed;
+    this->rowCount = table->blocksInBuckets[this->bucket][this->chainCount];
+    this->data.assign((size_t)this->rowCount * this->columnCount, 0);
+    this->readRows();
 }
 
 HashPage::HashPage(const string& tableName, int bucket, int chainCount, const vector<vector<int>>& rows) {
@@ -175,16 +893,89 @@ HashPage::HashPage(const string& tableName, int bucket, int chainCount, const ve
     this->tableName = tableName;
     this->bucket = bucket;
     this->chainCount = chainCount;
-    this->data = rows;
     this->rowCount = rows.size();
     this->columnCount = rows[0].size();
+    this->id = PageId(getRelationId(this->tableName), HASH_PAGE, this->bucket, this->chainCount);
+    if (Table *table = tableCatalogue.getTable(this->id.relation))
+        this->compressed = table->compressed;
+    this->setRows(rows);
     this->pageName = HASH_PAGE_NAME(this->tableName, this->bucket, this->chainCount);
 }
 
+/**
+ * @brief Views the binary page stored in bytes. The view stays empty if the
+ * page is not a binary page of this format, if it is compressed, or if values
+ * are not stored in host byte order.
+ *
+ * @param bytes 
+ * @param length 
+ */
+PageView::PageView(const char* bytes, size_t length) {
+#if !defined(TEXT_PAGES) && __BYTE_ORDER__ != __ORDER_BIG_ENDIAN__
+    PageHeader header;
+    if (!bytes || length < sizeof(PageHeader))
+        return;
+    memcpy(&header, bytes, sizeof(PageHeader));
+    if (header.version != PAGE_FORMAT_VERSION || header.encoded || length != sizeof(PageHeader) + (size_t)header.rowCount * header.columnCount * sizeof(int32_t))
+        return;
+    this->values = (const int32_t*)(bytes + sizeof(PageHeader));
+    this->rowCount = header.rowCount;
+    this->columnCount = header.columnCount;
+    this->layout = (PageLayout)header.layout;
+#endif
+}
+
+/**
+ * @brief Get the rows of the viewed page from rowIndex on, one after the
+ * other, gathering them into buffer if the page is not stored row after row
+ * 
+ * @param rowIndex 
+ * @param buffer 
+ * @return span<const int> empty if there is no such row
+ */
+span<const int> PageView::getRows(int rowIndex, vector<int>& buffer) const {
+    return rowsFrom(this->values, this->layout, this->rowCount, this->columnCount, rowIndex, buffer);
+}
+
+/**
+ * @brief Get row from the viewed page indexed by rowIndex, gathering it into
+ * buffer if the page is not stored row after row
+ * 
+ * @param rowIndex 
+ * @param buffer 
+ * @return span<const int> empty if there is no such row
+ */
+span<const int> PageView::getRow(int rowIndex, vector<int>& buffer) const {
+    if (rowIndex >= this->rowCount)
+        return span<const int>();
+    if (this->layout == ROW_LAYOUT)
+        return span<const int>(this->values + (size_t)rowIndex * this->columnCount, this->columnCount);
+    buffer.resize(this->columnCount);
+    for (int columnCounter = 0; columnCounter < this->columnCount; columnCounter++)
+        buffer[columnCounter] = this->values[(size_t)columnCounter * this->rowCount + rowIndex];
+    return buffer;
+}
+
+/**
+ * @brief Get all the values of column columnIndex of a viewed PAX page
+ * 
+ * @param columnIndex 
+ * @return span<const int> empty if the page is not a PAX page
+ */
+span<const int> PageView::getColumn(int columnIndex) const {
+    if (this->layout != PAX_LAYOUT || columnIndex >= this->columnCount)
+        return span<const int>();
+    return span<const int>(this->values + (size_t)columnIndex * this->rowCount, this->rowCount);
+}
+
 // VARIANT VISITORS
 
-string getPageName(const Pages& page) {
-    return visit([](auto&& arg){return arg.pageName;}, page);
+PageId getPageId(const Pages& page) {
+    return visit([](auto&& arg){return arg.id;}, page);
+}
+
+size_t getPageFootprint(const Pages& page) {
+    return visit([](auto&& arg){return arg.footprint();}, page);
 }
 
 void writePage(Pages& page) { // cannot gaurantee const on this, because calls a member function
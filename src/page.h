@@ -7,9 +7,11 @@
  * (equivalent to a block). The page class and the page.h header file are at the
  * bottom of the dependency tree when compiling files. 
  *<p>
- * Do NOT modify the Page class. If you find that modifications
- * are necessary, you may do so by posting the change you want to make on Moodle
- * or Teams with justification and gaining approval from the TAs. 
+ * In memory, a page is always uncompressed: data holds exactly rowCount *
+ * columnCount values in the order of its layout, whatever the page looks like
+ * on disk. Compression is applied only when the page is written. Pages in the
+ * pool are changed only through PageGuard::mutate, so that the buffer
+ * manager can mark them dirty and keep their zone maps up to date.
  *</p>
  */
 
@@ -17,6 +19,82 @@
 #define MATRIX_PAGE_NAME(matrix, row, col) ("../data/temp/" + (matrix) + "_M-Page_" + to_string(row) + "_" + to_string(col))
 #define HASH_PAGE_NAME(table, bucket, chain) ("../data/temp/" + (table) + "_H-Page_" + to_string(bucket) + "_" + to_string(chain))
 
+// Pages are stored in binary: a PageHeader followed by the values as
+// little-endian int32s, in the order given by the page's layout, or by the
+// encoded columns of the page if it is compressed. Build with TEXT_PAGES to
+// store whitespace separated text instead, which is easier to inspect while
+// debugging.
+#define PAGE_FORMAT_VERSION 3
+
+struct PageHeader {
+    int32_t version;
+    int32_t rowCount;
+    int32_t columnCount;
+    int32_t layout;
+    int32_t encoded;
+};
+
+enum PageKind {
+    TABLE_PAGE,
+    HASH_PAGE,
+    MATRIX_PAGE
+};
+
+/**
+ * @brief Order of the values inside a page. ROW_LAYOUT stores the page row
+ * after row; PAX_LAYOUT stores it column after column, so that an operator
+ * reading a few columns of a page gets each of them as one dense array.
+ *
+ */
+enum PageLayout {
+    ROW_LAYOUT,
+    PAX_LAYOUT
+};
+
+/**
+ * @brief Compact identifier of a page, used by the buffer manager to look pages
+ * up. relation is the interned id of the table or matrix name (see
+ * getRelationId); x and y are the page index for table pages, the bucket and
+ * chain for hash pages, and the block row and column for matrix pages. Pages
+ * of the same kind of a relation share a segment (see SegmentStore).
+ *
+ */
+struct PageId {
+    int relation = -1;
+    PageKind kind = TABLE_PAGE;
+    int x = 0;
+    int y = 0;
+
+    PageId() {}
+    PageId(int relation, PageKind kind, int x, int y = 0) : relation(relation), kind(kind), x(x), y(y) {}
+    bool operator==(const PageId& other) const;
+    PageId segment() const;
+};
+
+struct PageIdHash {
+    size_t operator()(const PageId& id) const;
+};
+
+int getRelationId(const string& relationName);
+const string& getRelationName(int relationId);
+
+/**
+ * @brief Smallest and largest value of each column of a page. The buffer
+ * manager keeps one for every table page and hash page written, so that scans
+ * can skip pages that cannot hold the rows they look for without reading them.
+ *
+ */
+struct ZoneMap {
+    vector<int> smallest;
+    vector<int> largest;
+
+    bool contains(span<const int> row) const;
+};
+
+// tells a cursor whether a page with the given zone map may hold rows it is
+// looking for
+typedef function<bool(const ZoneMap&)> PageFilter;
+
 class Page {
 
    protected:
@@ -24,12 +102,36 @@ class Page {
     // TODO: Remove rowCount and columnCount
     int columnCount;
     int rowCount;
+    PageLayout layout = ROW_LAYOUT;
+    // compress the page when writing it
+    bool compressed = false;
+    // rows of PAX pages handed out by getRow(rowIndex)
+    mutable vector<int> rowBuffer;
+    void readRows();
+    void setRows(const vector<vector<int>>& rows);
    
    public:
     // TODO: Make these protected
     string pageName = "";
-    vector<vector<int>> data;
-    vector<int> getRow(int rowIndex);
+    PageId id;
+    // rowCount rows of columnCount values each, one row after the other, or
+    // for PAX pages columnCount columns of rowCount values each
+    vector<int> data;
+    span<const int> getRow(int rowIndex) const;
+    span<const int> getRow(int rowIndex, vector<int>& buffer) const;
+    span<const int> getColumn(int columnIndex) const;
+    vector<vector<int>> getRows() const;
+    span<const int> getRows(int rowIndex, vector<int>& buffer) const;
+    int getRowCount() const;
+    int getColumnCount() const;
+    PageLayout getLayout() const;
+    void setLayout(PageLayout layout);
+    void setCompressed(bool compressed);
+    bool hasRow(span<const int> row) const;
+    ZoneMap getZoneMap() const;
+    void appendRow(span<const int> row);
+    int removeRow(span<const int> row);
+    size_t footprint() const;
     Page();
     void writePage();
     
@@ -42,6 +144,7 @@ class TablePage : public Page {
    public:
     TablePage();
     TablePage(string tableName, int pageIndex);
+    TablePage(const PageId& id);
     TablePage(string tableName, int pageIndex, vector<vector<int>> rows, int rowCount);
 };
 
@@ -51,6 +154,7 @@ class HashPage : public Page {
    public:
     HashPage();
     HashPage(const string& tableName, int bucket, int chainCount);
+    HashPage(const PageId& id);
     HashPage(const string& tableName, int bucket, int chainCount, const vector<vector<int>>& data);
 };
 
@@ -66,12 +170,34 @@ class MatrixPage : public Page {
     MatrixPage(const string& matrixName, int rowIndex, int colIndex);
     MatrixPage(const string& matrixName, int rowIndex, int colIndex, const vector<vector<int>>& data);
     bool writePage();
-    vector<vector<int>> getMatrix();
+    const vector<vector<int>>& getMatrix() const;
+    vector<vector<int>>& getMatrix();
+    size_t footprint() const;
 };
 
 typedef variant<Page, TablePage, HashPage, MatrixPage> Pages;
 
-string getPageName(const Pages& page);
+/**
+ * @brief Read-only view of a binary page in place, e.g. in a memory mapped
+ * segment, without copying it into a Page. A view with no values is empty:
+ * the page could not be viewed and has to be read through the buffer pool.
+ *
+ */
+struct PageView {
+    const int32_t* values = nullptr;
+    int rowCount = 0;
+    int columnCount = 0;
+    PageLayout layout = ROW_LAYOUT;
+
+    PageView() {}
+    PageView(const char* bytes, size_t length);
+    span<const int> getRow(int rowIndex, vector<int>& buffer) const;
+    span<const int> getRows(int rowIndex, vector<int>& buffer) const;
+    span<const int> getColumn(int columnIndex) const;
+};
+
+PageId getPageId(const Pages& page);
+size_t getPageFootprint(const Pages& page);
 void writePage(Pages& page);
 
 #endif
\ No newline at end of file
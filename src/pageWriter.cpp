@@ -0,0 +1,156 @@
+#include "global.h"
+
+PageWriter::PageWriter() {
+}
+
+PageWriter::~PageWriter() {
+    this->stop();
+}
+
+/**
+ * @brief Starts the background thread. At most capacity pages wait in the
+ * queue at any time.
+ *
+ * @param capacity
+ */
+void PageWriter::start(uint capacity) {
+    logger.log("PageWriter::start");
+    unique_lock<mutex> guard(this->lock);
+    this->capacity = max(capacity, 1u);
+    if (this->running)
+        return;
+    this->running = true;
+    this->worker = thread(&PageWriter::work, this);
+}
+
+/**
+ * @brief Writes out every queued page and stops the background thread.
+ *
+ */
+void PageWriter::stop() {
+    logger.log("PageWriter::stop");
+    {
+        unique_lock<mutex> guard(this->lock);
+        if (!this->running)
+            return;
+        this->running = false;
+    }
+    this->changed.notify_all();
+    this->worker.join();
+}
+
+bool PageWriter::isRunning() {
+    unique_lock<mutex> guard(this->lock);
+    return this->running;
+}
+
+/**
+ * @brief Body of the background thread. Takes pages off the queue in the order
+ * they were queued, and keeps going after stop() until the queue is empty.
+ *
+ */
+void PageWriter::work() {
+    unique_lock<mutex> guard(this->lock);
+    while (true) {
+        this->changed.wait(guard, [this] { return !this->running || !this->order.empty(); });
+        if (this->order.empty())
+            return;
+
+        this->writing = true;
+        this->writingId = this->order.front();
+        this->order.pop_front();
+        this->writingPage = move(this->queued[this->writingId]);
+        this->queued.erase(this->writingId);
+        this->changed.notify_all();
+
+        guard.unlock();
+        writePage(this->writingPage);
+        guard.lock();
+
+        this->writing = false;
+        this->writingPage = Page();
+        this->changed.notify_all();
+    }
+}
+
+/**
+ * @brief Queues page to be written. If an older version of the page is still
+ * queued, it is replaced. Blocks while the queue is full.
+ *
+ * @param page
+ */
+void PageWriter::enqueue(Pages page) {
+    logger.log("PageWriter::enqueue");
+    PageId id = getPageId(page);
+    unique_lock<mutex> guard(this->lock);
+    auto it = this->queued.find(id);
+    if (it != this->queued.end()) {
+        it->second = move(page);
+        return;
+    }
+    this->changed.wait(guard, [this] { return this->order.size() < this->capacity; });
+    this->order.push_back(id);
+    this->queued.emplace(id, move(page));
+    this->changed.notify_all();
+}
+
+/**
+ * @brief Serves reads of pages that have not reached the disk yet.
+ *
+ * @param id
+ * @param page set to the latest queued version of the page, if any
+ * @return true if the page is queued or being written
+ */
+bool PageWriter::lookup(const PageId& id, Pages& page) {
+    unique_lock<mutex> guard(this->lock);
+    auto it = this->queued.find(id);
+    if (it != this->queued.end()) {
+        page = it->second;
+        return true;
+    }
+    if (this->writing && this->writingId == id) {
+        page = this->writingPage;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Tells if page id is queued or being written, without copying it.
+ *
+ * @param id
+ * @return true if the page on disk is not up to date yet
+ */
+bool PageWriter::isPending(const PageId& id) {
+    unique_lock<mutex> guard(this->lock);
+    return this->queued.count(id) || (this->writing && this->writingId == id);
+}
+
+/**
+ * @brief Drops the queued writes of the pages that matches selects, and waits
+ * for the page being written to finish if it is one of them. Called before
+ * pages are deleted.
+ *
+ * @param matches
+ */
+void PageWriter::cancel(const function<bool(const PageId&)>& matches) {
+    unique_lock<mutex> guard(this->lock);
+    size_t queuedCount = this->order.size();
+    this->order.erase(remove_if(this->order.begin(), this->order.end(), matches), this->order.end());
+    if (this->order.size() != queuedCount) {
+        for (auto it = this->queued.begin(); it != this->queued.end();)
+            it = matches(it->first) ? this->queued.erase(it) : next(it);
+        this->changed.notify_all();
+    }
+    this->changed.wait(guard, [&] { return !this->writing || !matches(this->writingId); });
+}
+
+/**
+ * @brief Waits until every queued page has been written.
+ *
+ */
+void PageWriter::barrier() {
+    logger.log("PageWriter::barrier");
+    unique_lock<mutex> guard(this->lock);
+    this->changed.wait(guard, [this] { return this->order.empty() && !this->writing; });
+}
@@ -0,0 +1,45 @@
+#ifndef __PAGEWRITER_H
+#define __PAGEWRITER_H
+
+#include "page.h"
+
+/**
+ * @brief The PageWriter writes pages evicted from the buffer pool on a
+ * background thread, so that the query thread does not wait for a dirty
+ * victim to be written out. Pages wait in a bounded queue; enqueue blocks while
+ * the queue is full. Until a queued page has been written, its copy on disk is
+ * stale, so the buffer manager must look pages up here before reading them
+ * from disk, and cancel queued writes before deleting a page.
+ *
+ */
+class PageWriter {
+    mutex lock;
+    condition_variable changed;
+    thread worker;
+    bool running = false;
+
+    uint capacity;
+    deque<PageId> order;
+    unordered_map<PageId, Pages, PageIdHash> queued;
+
+    // page being written by the worker, no longer in queued
+    bool writing = false;
+    PageId writingId;
+    Pages writingPage;
+
+    void work();
+
+   public:
+    PageWriter();
+    ~PageWriter();
+    void start(uint capacity);
+    void stop();
+    bool isRunning();
+    void enqueue(Pages page);
+    bool lookup(const PageId& id, Pages& page);
+    bool isPending(const PageId& id);
+    void cancel(const function<bool(const PageId&)>& matches);
+    void barrier();
+};
+
+#endif
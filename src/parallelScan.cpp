@@ -0,0 +1,136 @@
+#include "global.h"
+
+/**
+ * @brief Number of worker threads of a parallel scan: THREAD_COUNT, or one
+ * per core if it is 0
+ *
+ * @return uint
+ */
+uint getThreadCount() {
+    if (THREAD_COUNT)
+        return THREAD_COUNT;
+    return max(1u, thread::hardware_concurrency());
+}
+
+/**
+ * @brief Splits table into morsels of about MORSEL_PAGES pages. The buckets
+ * of an indexed table are not split, so a morsel of an indexed table holds as
+ * many whole buckets as it takes to reach MORSEL_PAGES pages.
+ *
+ * @param table
+ * @param filter optional filter of the pages to read
+ */
+ParallelScan::ParallelScan(Table* table, PageFilter filter) {
+    logger.log("ParallelScan::ParallelScan");
+    this->table = table;
+    this->filter = filter;
+    this->bounds.push_back(0);
+    if (!table->indexed) {
+        for (int pageIndex = MORSEL_PAGES; pageIndex < (int)table->blockCount; pageIndex += MORSEL_PAGES)
+            this->bounds.push_back(pageIndex);
+        if (table->blockCount)
+            this->bounds.push_back(table->blockCount);
+        return;
+    }
+
+    int bucketCount = table->blocksInBuckets.size(), pageCount = 0;
+    for (int bucket = 0; bucket < bucketCount; bucket++) {
+        pageCount += table->blocksInBuckets[bucket].size();
+        if (pageCount >= MORSEL_PAGES || bucket == bucketCount - 1) {
+            this->bounds.push_back(bucket + 1);
+            pageCount = 0;
+        }
+    }
+}
+
+int ParallelScan::getMorselCount() {
+    return this->bounds.size() - 1;
+}
+
+/**
+ * @brief Scan over the pages, or the buckets, of morsel
+ *
+ * @param morsel
+ * @param ring
+ * @return ScanIterator
+ */
+ScanIterator ParallelScan::getMorsel(int morsel, BufferRing* ring) {
+    int first = this->bounds[morsel], end = this->bounds[morsel + 1];
+    if (!this->table->indexed)
+        return HeapScan(this->table, first, end, ring, this->filter);
+    vector<int> buckets(end - first);
+    iota(buckets.begin(), buckets.end(), first);
+    return IndexScan(this->table, buckets, ring, this->filter);
+}
+
+/**
+ * @brief Hands the morsels out to the workers, which call work on them, and
+ * calls emit on every morsel in order once it has been worked on. A worker
+ * does not take a morsel more than a window of morsels past the next one to
+ * be emitted, which bounds the results waiting to be emitted.
+ *
+ * @param work called on a worker thread for every morsel
+ * @param emit called on the calling thread for every morsel, in order
+ */
+void ParallelScan::runMorsels(const function<void(int morsel, ScanIterator& scan)>& work, const function<void(int morsel)>& emit) {
+    logger.log("ParallelScan::runMorsels");
+    int morselCount = this->getMorselCount();
+    int threadCount = min((int)getThreadCount(), morselCount);
+    if (threadCount <= 1) {
+        BufferRing ring(this->table->blockCount);
+        for (int morsel = 0; morsel < morselCount; morsel++) {
+            ScanIterator scan = this->getMorsel(morsel, &ring);
+            work(morsel, scan);
+            emit(morsel);
+        }
+        return;
+    }
+
+    mutex lock;
+    condition_variable changed;
+    int nextMorsel = 0, emitted = 0;
+    int window = 4 * threadCount;
+    vector<bool> done(morselCount, false);
+
+    auto worker = [&]() {
+        BufferRing ring(this->table->blockCount);
+        while (true) {
+            int morsel;
+            {
+                unique_lock<mutex> guard(lock);
+                changed.wait(guard, [&]() { return nextMorsel == morselCount || nextMorsel < emitted + window; });
+                if (nextMorsel == morselCount)
+                    return;
+                morsel = nextMorsel++;
+            }
+            {
+                ScanIterator scan = this->getMorsel(morsel, &ring);
+                work(morsel, scan);
+            }
+            {
+                lock_guard<mutex> guard(lock);
+                done[morsel] = true;
+            }
+            changed.notify_all();
+        }
+    };
+
+    vector<thread> workers;
+    for (int threadCounter = 0; threadCounter < threadCount; threadCounter++)
+        workers.emplace_back(worker);
+
+    for (int morsel = 0; morsel < morselCount; morsel++) {
+        {
+            unique_lock<mutex> guard(lock);
+            changed.wait(guard, [&]() { return done[morsel]; });
+        }
+        emit(morsel);
+        {
+            lock_guard<mutex> guard(lock);
+            emitted = morsel + 1;
+        }
+        changed.notify_all();
+    }
+    for (thread& workerThread : workers)
+        workerThread.join();
+}
@@ -0,0 +1,62 @@
+#ifndef __PARALLELSCAN_H
+#define __PARALLELSCAN_H
+
+#include "table.h"
+
+// pages in a morsel, the unit of work handed to a worker thread
+#ifndef MORSEL_PAGES
+#define MORSEL_PAGES 8
+#endif
+
+/**
+ * @brief Morsel-driven parallel scan of a table. The table is split into
+ * morsels of about MORSEL_PAGES pages (runs of pages, or of whole buckets for
+ * indexed tables), which a pool of worker threads takes one at a time, each
+ * reading it through its own ScanIterator and BufferRing. What a worker makes
+ * of a morsel is handed back to the calling thread in morsel order, so results
+ * come out in the same order as those of a serial scan. Workers stay at most
+ * a few morsels ahead of the morsel being handed back.
+ *
+ * The number of workers is set with SET THREADS, one per core by default. With
+ * a single worker the morsels are read on the calling thread.
+ *
+ */
+class ParallelScan {
+    Table* table;
+    PageFilter filter;
+    // the first page (or bucket) of every morsel, and one past the last one
+    vector<int> bounds;
+
+    ScanIterator getMorsel(int morsel, BufferRing* ring);
+    void runMorsels(const function<void(int morsel, ScanIterator& scan)>& work, const function<void(int morsel)>& emit);
+
+   public:
+    ParallelScan(Table* table, PageFilter filter = nullptr);
+    int getMorselCount();
+
+    template <typename Result>
+    void run(const function<void(ScanIterator& scan, Result& result)>& work, const function<void(Result& result)>& emit);
+};
+
+uint getThreadCount();
+
+/**
+ * @brief Runs work on every morsel, on the worker threads, and then emit on
+ * its result, on the calling thread, one morsel after the other.
+ *
+ * @tparam Result what work makes of a morsel, e.g. its rows that qualify or a
+ * partial aggregate
+ * @param work
+ * @param emit
+ */
+template <typename Result>
+void ParallelScan::run(const function<void(ScanIterator& scan, Result& result)>& work, const function<void(Result& result)>& emit) {
+    vector<Result> results(this->getMorselCount());
+    this->runMorsels([&](int morsel, ScanIterator& scan) { work(scan, results[morsel]); },
+                     [&](int morsel) {
+                         emit(results[morsel]);
+                         results[morsel] = Result();
+                     });
+}
+
+#endif
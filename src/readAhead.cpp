@@ -0,0 +1,105 @@
+#include "global.h"
+
+ReadAhead::ReadAhead() {
+    this->depth = READ_AHEAD_PAGES;
+}
+
+/**
+ * @brief Sets the number of pages hinted ahead of a sequential reader. 0 turns
+ * read-ahead off.
+ *
+ * @param depth 
+ */
+void ReadAhead::setDepth(uint depth) {
+    logger.log("ReadAhead::setDepth");
+    this->depth = depth;
+    this->lastRead.clear();
+    this->hintedUpTo.clear();
+}
+
+/**
+ * @brief Asks the kernel to read page id into the page cache.
+ *
+ * @param id 
+ */
+void ReadAhead::hint(const PageId& id) {
+    logger.log("ReadAhead::hint");
+    segmentStore.prefetch(id);
+}
+
+/**
+ * @brief Called for every table page requested. On a sequential read, hints
+ * the next depth pages of the table that are not cached in the pool and have
+ * not been hinted yet.
+ *
+ * @param id 
+ * @param cached tells if a page is already in the pool
+ */
+void ReadAhead::onTablePage(const PageId& id, const function<bool(const PageId&)>& cached) {
+    if (!this->depth)
+        return;
+
+    int pageIndex = id.x;
+    PageId key(id.relation, TABLE_PAGE, -1);
+    auto last = this->lastRead.find(key);
+    bool sequential = last != this->lastRead.end() && last->second.first == pageIndex - 1;
+    this->lastRead[key] = {pageIndex, 0};
+    Table* table = sequential ? tableCatalogue.getTable(id.relation) : nullptr;
+    if (!table) {
+        this->hintedUpTo.erase(key);
+        return;
+    }
+
+    auto hinted = this->hintedUpTo.emplace(key, make_pair(pageIndex, 0)).first;
+    int lastPage = min(pageIndex + (int)this->depth, (int)table->blockCount - 1);
+    for (int next = max(hinted->second.first, pageIndex) + 1; next <= lastPage; next++) {
+        PageId nextId(id.relation, TABLE_PAGE, next);
+        if (!cached(nextId))
+            this->hint(nextId);
+        hinted->second.first = next;
+    }
+}
+
+/**
+ * @brief Called for every hash page requested. On a chain or bucket walk,
+ * hints the next depth pages in bucket order: the rest of the current chain,
+ * then the chains of the following non-empty buckets.
+ *
+ * @param id bucket and chainCount of the page
+ * @param cached tells if a page is already in the pool
+ */
+void ReadAhead::onHashPage(const PageId& id, const function<bool(const PageId&)>& cached) {
+    if (!this->depth)
+        return;
+
+    int bucket = id.x, chainCount = id.y;
+    PageId key(id.relation, HASH_PAGE, -1, -1);
+    auto last = this->lastRead.find(key);
+    bool sequential = last != this->lastRead.end() &&
+                      ((last->second.first == bucket && last->second.second == chainCount - 1) ||
+                       (last->second.first < bucket && chainCount == 0));
+    this->lastRead[key] = {bucket, chainCount};
+    Table* table = sequential ? tableCatalogue.getTable(id.relation) : nullptr;
+    if (!table) {
+        this->hintedUpTo.erase(key);
+        return;
+    }
+
+    auto hinted = this->hintedUpTo.emplace(key, make_pair(bucket, chainCount)).first;
+    int bucketCount = table->blocksInBuckets.size();
+    pair<int, int> next = {bucket, chainCount};
+    for (uint ahead = 0; ahead < this->depth; ahead++) {
+        next.second++;
+        while (next.first < bucketCount && next.second >= (int)table->blocksInBuckets[next.first].size())
+            next = {next.first + 1, 0};
+        if (next.first >= bucketCount)
+            break;
+        if (next <= hinted->second)
+            continue;
+
+        PageId nextId(id.relation, HASH_PAGE, next.first, next.second);
+        if (!cached(nextId))
+            this->hint(nextId);
+        hinted->second = next;
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef __READAHEAD_H
+#define __READAHEAD_H
+
+#include "page.h"
+
+#ifndef READ_AHEAD_PAGES
+#define READ_AHEAD_PAGES 4
+#endif
+
+/**
+ * @brief ReadAhead watches the pages requested from the buffer manager and,
+ * once a table is being read sequentially (page i after page i-1, or the
+ * next page of a bucket chain or the first page of a later bucket), asks the
+ * kernel to start reading the next few pages with posix_fadvise. The pages
+ * are still read on the query thread when they are requested, but they are
+ * then already in the page cache.
+ *
+ */
+class ReadAhead {
+    uint depth;
+
+    // last page requested and last page hinted, per relation. table pages
+    // only use the first of the pair
+    unordered_map<PageId, pair<int, int>, PageIdHash> lastRead;
+    unordered_map<PageId, pair<int, int>, PageIdHash> hintedUpTo;
+
+    void hint(const PageId& id);
+
+   public:
+    ReadAhead();
+    void setDepth(uint depth);
+    void onTablePage(const PageId& id, const function<bool(const PageId&)>& cached);
+    void onHashPage(const PageId& id, const function<bool(const PageId&)>& cached);
+};
+
+#endif
@@ -0,0 +1,165 @@
+#include "global.h"
+
+void FIFOPolicy::insert(int frame, const PageId& page) {
+    this->positions[frame] = this->queue.insert(this->queue.end(), frame);
+}
+
+void FIFOPolicy::access(int frame) {
+}
+
+void FIFOPolicy::erase(int frame) {
+    auto it = this->positions.find(frame);
+    if (it == this->positions.end())
+        return;
+    this->queue.erase(it->second);
+    this->positions.erase(it);
+}
+
+/**
+ * @brief Returns the evictable frame closest to the front of the queue, or -1
+ * if there is none.
+ *
+ * @return int 
+ */
+int FIFOPolicy::victim(const function<bool(int)>& evictable) {
+    for (int frame : this->queue)
+        if (evictable(frame))
+            return frame;
+    return -1;
+}
+
+int FIFOPolicy::size() {
+    return this->queue.size();
+}
+
+void LRUPolicy::access(int frame) {
+    auto it = this->positions.find(frame);
+    if (it == this->positions.end())
+        return;
+    this->queue.splice(this->queue.end(), this->queue, it->second);
+}
+
+void ClockPolicy::insert(int frame, const PageId& page) {
+    if (frame >= this->occupied.size()) {
+        this->occupied.resize(frame + 1, false);
+        this->referenced.resize(frame + 1, false);
+    }
+    if (!this->occupied[frame])
+        this->occupiedCount++;
+    this->occupied[frame] = true;
+    this->referenced[frame] = false;
+}
+
+void ClockPolicy::access(int frame) {
+    if (frame < this->referenced.size())
+        this->referenced[frame] = true;
+}
+
+void ClockPolicy::erase(int frame) {
+    if (frame >= this->occupied.size() || !this->occupied[frame])
+        return;
+    this->occupied[frame] = false;
+    this->referenced[frame] = false;
+    this->occupiedCount--;
+}
+
+/**
+ * @brief Sweeps the clock hand until it finds an evictable frame whose
+ * reference bit is unset, clearing the bits it passes over. Two full sweeps
+ * always suffice.
+ *
+ * @return int 
+ */
+int ClockPolicy::victim(const function<bool(int)>& evictable) {
+    if (this->occupiedCount == 0)
+        return -1;
+    int frameCount = this->occupied.size();
+    for (int step = 0; step < 2 * frameCount; step++) {
+        int frame = this->hand;
+        this->hand = (this->hand + 1) % frameCount;
+        if (!this->occupied[frame] || !evictable(frame))
+            continue;
+        if (this->referenced[frame]) {
+            this->referenced[frame] = false;
+            continue;
+        }
+        return frame;
+    }
+    return -1;
+}
+
+void TwoQueuePolicy::insert(int frame, const PageId& page) {
+    this->pages[frame] = page;
+    auto ghost = this->ghostPositions.find(page);
+    if (ghost != this->ghostPositions.end()) {
+        // seen again after leaving probation, so it is hot
+        this->ghosts.erase(ghost->second);
+        this->ghostPositions.erase(ghost);
+        this->main.insert(frame, page);
+        this->inMain[frame] = true;
+    } else {
+        this->probation.insert(frame, page);
+        this->inMain[frame] = false;
+    }
+}
+
+void TwoQueuePolicy::access(int frame) {
+    if (this->inMain[frame])
+        this->main.access(frame);
+}
+
+void TwoQueuePolicy::erase(int frame) {
+    if (this->inMain[frame])
+        this->main.erase(frame);
+    else
+        this->probation.erase(frame);
+    this->inMain.erase(frame);
+    this->pages.erase(frame);
+}
+
+/**
+ * @brief Evicts from probation while it holds more than a quarter of the pool
+ * (or when the main queue is empty), remembering the evicted page's id so
+ * that a second request promotes it. Otherwise evicts the least recently used
+ * page of the main queue. If the chosen queue only holds pinned frames, the
+ * other queue is tried.
+ *
+ * @return int 
+ */
+int TwoQueuePolicy::victim(const function<bool(int)>& evictable) {
+    int probationLimit = max(1u, BLOCK_COUNT / 4);
+    int frame = -1;
+    if (this->probation.size() > probationLimit || this->main.size() == 0)
+        frame = this->probation.victim(evictable);
+    if (frame == -1)
+        frame = this->main.victim(evictable);
+    if (frame == -1)
+        frame = this->probation.victim(evictable);
+    if (frame != -1 && !this->inMain[frame])
+        this->remember(this->pages[frame]);
+    return frame;
+}
+
+/**
+ * @brief Adds a page id to A1out, forgetting the oldest ones beyond half the
+ * pool size.
+ *
+ * @param page 
+ */
+void TwoQueuePolicy::remember(const PageId& page) {
+    int ghostLimit = max(1u, BLOCK_COUNT / 2);
+    this->ghostPositions[page] = this->ghosts.insert(this->ghosts.end(), page);
+    while (this->ghosts.size() > ghostLimit) {
+        this->ghostPositions.erase(this->ghosts.front());
+        this->ghosts.pop_front();
+    }
+}
+
+ReplacementPolicy* makeReplacementPolicy(ReplacementStrategy strategy) {
+    switch (strategy) {
+        case LRU: return new LRUPolicy();
+        case CLOCK: return new ClockPolicy();
+        case TWO_Q: return new TwoQueuePolicy();
+        default: return new FIFOPolicy();
+    }
+}
@@ -0,0 +1,104 @@
+#ifndef __REPLACEMENTPOLICY_H
+#define __REPLACEMENTPOLICY_H
+
+#include "page.h"
+
+enum ReplacementStrategy {
+    FIFO,
+    LRU,
+    CLOCK,
+    TWO_Q
+};
+
+/**
+ * @brief A ReplacementPolicy decides which frame of the buffer pool is given
+ * up when a new page has to be brought in. The BufferManager informs the
+ * policy whenever a frame is filled, hit or emptied, and asks it for a victim
+ * when the pool is full. Frames are identified by their slot in the pool.
+ * Frames for which evictable returns false (pinned frames) must never be
+ * chosen.
+ *
+ */
+class ReplacementPolicy {
+   public:
+    virtual ~ReplacementPolicy() {}
+    virtual void insert(int frame, const PageId& page) = 0;
+    virtual void access(int frame) = 0;
+    virtual void erase(int frame) = 0;
+    virtual int victim(const function<bool(int)>& evictable) = 0;
+};
+
+/**
+ * @brief First in, first out. Hits do not change the order of eviction.
+ *
+ */
+class FIFOPolicy : public ReplacementPolicy {
+   protected:
+    list<int> queue;
+    unordered_map<int, list<int>::iterator> positions;
+
+   public:
+    void insert(int frame, const PageId& page);
+    void access(int frame);
+    void erase(int frame);
+    int victim(const function<bool(int)>& evictable);
+    int size();
+};
+
+/**
+ * @brief Least recently used. Every hit moves the frame to the back of the
+ * queue, so the frame at the front is the one untouched for the longest.
+ *
+ */
+class LRUPolicy : public FIFOPolicy {
+   public:
+    void access(int frame);
+};
+
+/**
+ * @brief Second chance approximation of LRU. Hits only set a reference bit;
+ * the clock hand clears bits as it sweeps and evicts the first frame found
+ * with its bit unset.
+ *
+ */
+class ClockPolicy : public ReplacementPolicy {
+    vector<bool> occupied;
+    vector<bool> referenced;
+    int hand = 0;
+    int occupiedCount = 0;
+
+   public:
+    void insert(int frame, const PageId& page);
+    void access(int frame);
+    void erase(int frame);
+    int victim(const function<bool(int)>& evictable);
+};
+
+/**
+ * @brief Simplified 2Q. Pages enter a FIFO probation queue (A1in) and are only
+ * promoted to the LRU main queue (Am) when they are requested again after
+ * having been evicted from probation, which is remembered through a bounded
+ * list of page ids (A1out). Pages read once by a scan therefore never push
+ * the hot pages out of Am.
+ *
+ */
+class TwoQueuePolicy : public ReplacementPolicy {
+    FIFOPolicy probation;
+    LRUPolicy main;
+    unordered_map<int, bool> inMain;
+    unordered_map<int, PageId> pages;
+
+    list<PageId> ghosts;
+    unordered_map<PageId, list<PageId>::iterator, PageIdHash> ghostPositions;
+    void remember(const PageId& page);
+
+   public:
+    void insert(int frame, const PageId& page);
+    void access(int frame);
+    void erase(int frame);
+    int victim(const function<bool(int)>& evictable);
+};
+
+ReplacementPolicy* makeReplacementPolicy(ReplacementStrategy strategy);
+
+#endif
@@ -0,0 +1,145 @@
+#include "global.h"
+
+HeapScan::HeapScan(Table* table, BufferRing* ring, PageFilter filter) {
+    logger.log("HeapScan::HeapScan");
+    this->cursor = table->getCursor(ring, filter);
+}
+
+HeapScan::HeapScan(Table* table, int firstPage, int endPage, BufferRing* ring, PageFilter filter) {
+    logger.log("HeapScan::HeapScan");
+    this->cursor = Cursor(table->tableName, firstPage, ring, filter, endPage);
+}
+
+int HeapScan::nextBatch(RowBatch& batch) {
+    return this->cursor.nextBatch(batch);
+}
+
+int HeapScan::nextColumns(const vector<int>& columnIndices, vector<span<const int>>& columns) {
+    return this->cursor.getNextColumns(columnIndices, columns);
+}
+
+BucketScan::BucketScan(Table* table, BufferRing* ring, PageFilter filter) {
+    logger.log("BucketScan::BucketScan");
+    this->cursor = table->getCursor(0, 0, ring, filter);
+}
+
+int BucketScan::nextBatch(RowBatch& batch) {
+    return this->cursor.nextBatchInAllBuckets(batch);
+}
+
+/**
+ * @brief Construct a new IndexScan over the chains of buckets. Empty buckets
+ * are left out.
+ *
+ * @param table
+ * @param buckets
+ * @param ring optional buffer ring for large scans
+ * @param filter optional filter of the pages to read
+ */
+IndexScan::IndexScan(Table* table, const vector<int>& buckets, BufferRing* ring, PageFilter filter) {
+    logger.log("IndexScan::IndexScan");
+    this->table = table;
+    this->ring = ring;
+    this->filter = filter;
+    for (int bucket : buckets)
+        if (table->blocksInBuckets[bucket].size())
+            this->buckets.push_back(bucket);
+    if (this->buckets.size())
+        this->cursor = table->getCursor(this->buckets[0], 0, ring, filter, true);
+}
+
+/**
+ * @brief Reads the rest of the current page of the current bucket, moving on
+ * to the next bucket once its chain has been read.
+ *
+ * @param batch
+ * @return int number of rows in batch, 0 once every bucket has been read
+ */
+int IndexScan::nextBatch(RowBatch& batch) {
+    logger.log("IndexScan::nextBatch");
+    while (this->bucketPointer < this->buckets.size()) {
+        if (this->cursor.nextBatchInBucket(batch))
+            return batch.rowCount;
+        if (++this->bucketPointer < this->buckets.size())
+            this->cursor = this->table->getCursor(this->buckets[this->bucketPointer], 0, this->ring, this->filter, true);
+    }
+    batch = RowBatch();
+    return 0;
+}
+
+OrderedIndexScan::OrderedIndexScan(Table* table, long long low, long long high, bool descending, BufferRing* ring, PageFilter filter)
+    : IndexScan(table, bucketsBetween(table, low, high, descending), ring, filter) {
+}
+
+/**
+ * @brief Non-empty buckets of table whose range of keys overlaps [low, high],
+ * in the order they are to be read. As the ranges of the buckets are in key
+ * order, the walk stops at the first bucket past the range.
+ *
+ * @param table
+ * @param low
+ * @param high
+ * @param descending
+ * @return vector<int>
+ */
+vector<int> OrderedIndexScan::bucketsBetween(Table* table, long long low, long long high, bool descending) {
+    vector<int> buckets;
+    int bucketCount = table->blocksInBuckets.size();
+    for (int counter = 0; counter < bucketCount; counter++) {
+        int bucket = descending ? bucketCount - 1 - counter : counter;
+        if (!table->blocksInBuckets[bucket].size())
+            continue;
+        const pair<int, int>& range = table->bucketRanges[bucket];
+        if (descending ? range.second < low : range.first > high)
+            break;
+        if (range.first <= high && range.second >= low)
+            buckets.push_back(bucket);
+    }
+    return buckets;
+}
+
+ScanIterator::ScanIterator(HeapScan scan) : scan(std::move(scan)) {}
+ScanIterator::ScanIterator(BucketScan scan) : scan(std::move(scan)) {}
+ScanIterator::ScanIterator(IndexScan scan) : scan(std::move(scan)) {}
+ScanIterator::ScanIterator(OrderedIndexScan scan) : scan(std::move(scan)) {}
+
+/**
+ * @brief Reads the next page of rows, or what is left of it, at once. The
+ * rows stay valid until the next call.
+ *
+ * @param batch
+ * @return int number of rows in batch, 0 once the scan is over
+ */
+int ScanIterator::nextBatch(RowBatch& batch) {
+    return visit([&](auto& scan) { return scan.nextBatch(batch); }, this->scan);
+}
+
+/**
+ * @brief Reads the rest of the current page a column at a time, see
+ * Cursor::getNextColumns. Only heap scans over tables in PAX layout read
+ * columns.
+ *
+ * @param columnIndices
+ * @param columns
+ * @return int number of rows in columns, 0 once the scan is over
+ */
+int ScanIterator::nextColumns(const vector<int>& columnIndices, vector<span<const int>>& columns) {
+    HeapScan* heapScan = get_if<HeapScan>(&this->scan);
+    return heapScan ? heapScan->nextColumns(columnIndices, columns) : 0;
+}
+
+/**
+ * @brief Reads the next row. The row stays valid until the scan moves on to
+ * the next page. Rows are read either through next or through nextBatch, not
+ * both.
+ *
+ * @return span<const int> empty once the scan is over
+ */
+span<const int> ScanIterator::next() {
+    while (this->batchPointer >= this->batch.rowCount) {
+        if (!this->nextBatch(this->batch))
+            return span<const int>();
+        this->batchPointer = 0;
+    }
+    return this->batch[this->batchPointer++];
+}
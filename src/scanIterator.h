@@ -0,0 +1,92 @@
+#ifndef __SCANITERATOR_H
+#define __SCANITERATOR_H
+
+#include "cursor.h"
+
+/**
+ * @brief Reads the pages of an unindexed table in order, or only the pages
+ * from firstPage up to endPage.
+ *
+ */
+class HeapScan {
+    Cursor cursor;
+
+   public:
+    HeapScan() {}
+    HeapScan(Table* table, BufferRing* ring, PageFilter filter);
+    HeapScan(Table* table, int firstPage, int endPage, BufferRing* ring, PageFilter filter);
+    int nextBatch(RowBatch& batch);
+    int nextColumns(const vector<int>& columnIndices, vector<span<const int>>& columns);
+};
+
+/**
+ * @brief Reads every bucket chain of an indexed table (hash or B+ tree), one
+ * bucket after the other.
+ *
+ */
+class BucketScan {
+    Cursor cursor;
+
+   public:
+    BucketScan(Table* table, BufferRing* ring, PageFilter filter);
+    int nextBatch(RowBatch& batch);
+};
+
+/**
+ * @brief Reads the chains of the given buckets of an indexed table only, in
+ * the order given, e.g. the buckets an index lookup found to hold the rows
+ * looked for.
+ *
+ */
+class IndexScan {
+    Table* table;
+    BufferRing* ring;
+    PageFilter filter;
+    vector<int> buckets;
+    int bucketPointer = 0;
+    Cursor cursor;
+
+   public:
+    IndexScan(Table* table, const vector<int>& buckets, BufferRing* ring, PageFilter filter);
+    int nextBatch(RowBatch& batch);
+};
+
+/**
+ * @brief Reads the buckets of a B+ tree indexed table whose key range overlaps
+ * [low, high], in key order of the indexed column (or in reverse). The order
+ * is by bucket: the rows of a bucket come before those of later buckets, but
+ * are not sorted among themselves.
+ *
+ */
+class OrderedIndexScan : public IndexScan {
+    static vector<int> bucketsBetween(Table* table, long long low, long long high, bool descending);
+
+   public:
+    OrderedIndexScan(Table* table, long long low, long long high, bool descending, BufferRing* ring, PageFilter filter);
+};
+
+/**
+ * @brief The access method an operator reads a table through. Which of the
+ * scans above is used is decided once, when the iterator is created (see
+ * Table::getScan), so that operators read heap tables and bucket chains alike,
+ * a row or a page of rows at a time, without checking how the table is stored
+ * for every row.
+ *
+ */
+class ScanIterator {
+    variant<HeapScan, BucketScan, IndexScan, OrderedIndexScan> scan;
+    RowBatch batch;
+    int batchPointer = 0;
+
+   public:
+    ScanIterator() {}
+    ScanIterator(HeapScan scan);
+    ScanIterator(BucketScan scan);
+    ScanIterator(IndexScan scan);
+    ScanIterator(OrderedIndexScan scan);
+    int nextBatch(RowBatch& batch);
+    int nextColumns(const vector<int>& columnIndices, vector<span<const int>>& columns);
+    span<const int> next();
+};
+
+#endif
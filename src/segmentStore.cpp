@@ -0,0 +1,281 @@
+#include "global.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+/**
+ * @brief File holding the pages of segment, e.g. "../data/temp/R_T-Segment"
+ * for the table pages of R.
+ *
+ * @param segment
+ * @return string
+ */
+static string segmentName(const PageId& segment) {
+    string name = "../data/temp/" + getRelationName(segment.relation);
+    switch (segment.kind) {
+        case HASH_PAGE: return name + "_H-Segment";
+        case MATRIX_PAGE: return name + "_M-Segment";
+        default: return name + "_T-Segment";
+    }
+}
+
+SegmentStore::~SegmentStore() {
+    for (auto& entry : this->segments) {
+        this->unmap(entry.second);
+        if (entry.second.fd != -1)
+            close(entry.second.fd);
+    }
+}
+
+/**
+ * @brief Size of a slot: a binary page of BLOCK_SIZE and its header fit in
+ * one. Larger pages take several consecutive slots.
+ *
+ * @return size_t
+ */
+size_t SegmentStore::slotSize() {
+    return sizeof(PageHeader) + (size_t)(BLOCK_SIZE * 1024);
+}
+
+/**
+ * @brief Capacity of a new extent for a page of bytes bytes: whole slots for
+ * full pages, and the smallest of half, a quarter, an eighth or a sixteenth
+ * of a slot for smaller ones, such as compressed pages. A page that grows a
+ * little at a time therefore only moves a few times before it fills a slot.
+ *
+ * @param bytes
+ * @return size_t
+ */
+size_t SegmentStore::extentSize(size_t bytes) {
+    size_t capacity = this->slotSize();
+    if (bytes > capacity)
+        return (bytes + capacity - 1) / capacity * capacity;
+    for (int halvings = 0; halvings < 4 && capacity / 2 >= bytes; halvings++)
+        capacity /= 2;
+    return capacity;
+}
+
+/**
+ * @brief Finds the segment that page id belongs to, opening its file if
+ * create is set and it has none yet.
+ *
+ * @param id
+ * @param create
+ * @return Segment* or nullptr
+ */
+SegmentStore::Segment* SegmentStore::getSegment(const PageId& id, bool create) {
+    auto it = this->segments.find(id.segment());
+    if (it != this->segments.end())
+        return &it->second;
+    if (!create)
+        return nullptr;
+
+    Segment& segment = this->segments[id.segment()];
+    segment.fd = open(segmentName(id.segment()).c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (segment.fd == -1)
+        logger.error("SegmentStore::getSegment: cannot open ", segmentName(id.segment()));
+    return &segment;
+}
+
+void SegmentStore::release(Segment& segment, const Extent& extent) {
+    segment.freeExtents.emplace(extent.capacity, extent.offset);
+}
+
+/**
+ * @brief Number of bytes stored for page id, 0 if it was never written.
+ *
+ * @param id
+ * @return size_t
+ */
+size_t SegmentStore::size(const PageId& id) {
+    unique_lock<mutex> guard(this->lock);
+    Segment* segment = this->getSegment(id, false);
+    if (!segment || !segment->extents.count(id))
+        return 0;
+    return segment->extents[id].length;
+}
+
+/**
+ * @brief Reads up to bytes bytes of page id into buffer.
+ *
+ * @param id
+ * @param buffer
+ * @param bytes
+ * @return ssize_t bytes read, -1 if the page was never written
+ */
+ssize_t SegmentStore::read(const PageId& id, void* buffer, size_t bytes) {
+    unique_lock<mutex> guard(this->lock);
+    Segment* segment = this->getSegment(id, false);
+    if (!segment)
+        return -1;
+    auto it = segment->extents.find(id);
+    if (it == segment->extents.end())
+        return -1;
+    return pread(segment->fd, buffer, min(bytes, it->second.length), it->second.offset);
+}
+
+/**
+ * @brief Writes bytes bytes of buffer as the contents of page id. The page is
+ * rewritten in place if its extent is large enough; otherwise it moves to a
+ * free extent that is, or to the end of the segment.
+ *
+ * @param id
+ * @param buffer
+ * @param bytes
+ * @return true if the page was written
+ */
+bool SegmentStore::write(const PageId& id, const void* buffer, size_t bytes) {
+    unique_lock<mutex> guard(this->lock);
+    Segment* segment = this->getSegment(id, true);
+    if (segment->fd == -1)
+        return false;
+
+    auto it = segment->extents.find(id);
+    if (it != segment->extents.end() && it->second.capacity < bytes) {
+        this->release(*segment, it->second);
+        segment->extents.erase(it);
+        it = segment->extents.end();
+    }
+    if (it == segment->extents.end()) {
+        Extent extent;
+        auto free = segment->freeExtents.lower_bound(bytes);
+        if (free != segment->freeExtents.end()) {
+            extent.capacity = free->first;
+            extent.offset = free->second;
+            segment->freeExtents.erase(free);
+        } else {
+            extent.capacity = this->extentSize(bytes);
+            extent.offset = segment->end;
+            segment->end += extent.capacity;
+        }
+        it = segment->extents.emplace(id, extent).first;
+    }
+    it->second.length = bytes;
+    return pwrite(segment->fd, buffer, bytes, it->second.offset) == (ssize_t)bytes;
+}
+
+/**
+ * @brief Deletes page id. Its extent goes to the free list of the segment.
+ *
+ * @param id
+ */
+void SegmentStore::erase(const PageId& id) {
+    unique_lock<mutex> guard(this->lock);
+    Segment* segment = this->getSegment(id, false);
+    if (!segment)
+        return;
+    auto it = segment->extents.find(id);
+    if (it == segment->extents.end())
+        return;
+    this->release(*segment, it->second);
+    segment->extents.erase(it);
+}
+
+/**
+ * @brief Deletes every page of segment along with its file.
+ *
+ * @param segment id of any page of the segment
+ */
+void SegmentStore::drop(const PageId& segment) {
+    logger.log("SegmentStore::drop");
+    unique_lock<mutex> guard(this->lock);
+    auto it = this->segments.find(segment.segment());
+    if (it == this->segments.end())
+        return;
+    this->unmap(it->second);
+    if (it->second.fd != -1)
+        close(it->second.fd);
+    unlink(segmentName(segment.segment()).c_str());
+    this->segments.erase(it);
+}
+
+/**
+ * @brief Asks the kernel to start reading page id into the page cache.
+ *
+ * @param id
+ */
+void SegmentStore::prefetch(const PageId& id) {
+    unique_lock<mutex> guard(this->lock);
+    Segment* segment = this->getSegment(id, false);
+    if (!segment)
+        return;
+    auto it = segment->extents.find(id);
+    if (it != segment->extents.end())
+        posix_fadvise(segment->fd, it->second.offset, it->second.length, POSIX_FADV_WILLNEED);
+}
+
+/**
+ * @brief Maps the segment of page id into memory, if it is not mapped yet or
+ * has grown past its mapping, and returns where the page starts.
+ *
+ * @param id
+ * @param length set to the number of bytes stored for the page
+ * @return const char* nullptr if the page was never written or the segment
+ * cannot be mapped
+ */
+const char* SegmentStore::map(const PageId& id, size_t& length) {
+    unique_lock<mutex> guard(this->lock);
+    Segment* segment = this->getSegment(id, false);
+    if (!segment)
+        return nullptr;
+    auto it = segment->extents.find(id);
+    if (it == segment->extents.end())
+        return nullptr;
+
+    size_t end = it->second.offset + it->second.length;
+    if (segment->mappings.empty() || segment->mappings.back().second < end) {
+        logger.log("SegmentStore::map");
+        void* mapping = mmap(nullptr, segment->end, PROT_READ, MAP_SHARED, segment->fd, 0);
+        if (mapping == MAP_FAILED)
+            return nullptr;
+        segment->mappings.emplace_back((char*)mapping, segment->end);
+    }
+    length = it->second.length;
+    return segment->mappings.back().first + it->second.offset;
+}
+
+void SegmentStore::unmap(Segment& segment) {
+    for (auto& mapping : segment.mappings)
+        munmap(mapping.first, mapping.second);
+    segment.mappings.clear();
+}
+
+/**
+ * @brief Unmaps segment. Views into it must no longer be in use.
+ *
+ * @param segment id of any page of the segment
+ */
+void SegmentStore::unmap(const PageId& segment) {
+    logger.log("SegmentStore::unmap");
+    unique_lock<mutex> guard(this->lock);
+    auto it = this->segments.find(segment.segment());
+    if (it != this->segments.end())
+        this->unmap(it->second);
+}
+
+/**
+ * @brief Passes advice on the mapping of a segment to madvise. An id with a
+ * negative x, as returned by PageId::segment, advises the whole mapping;
+ * otherwise only the extent of page id.
+ *
+ * @param id
+ * @param advice MADV_SEQUENTIAL, MADV_WILLNEED, ...
+ */
+void SegmentStore::advise(const PageId& id, int advice) {
+    unique_lock<mutex> guard(this->lock);
+    Segment* segment = this->getSegment(id, false);
+    if (!segment || segment->mappings.empty())
+        return;
+    auto& mapping = segment->mappings.back();
+    if (id.x < 0) {
+        madvise(mapping.first, mapping.second, advice);
+        return;
+    }
+    auto it = segment->extents.find(id);
+    if (it == segment->extents.end() || it->second.offset + it->second.length > mapping.second)
+        return;
+    // madvise needs a page aligned address
+    size_t pageSize = sysconf(_SC_PAGESIZE);
+    size_t start = it->second.offset / pageSize * pageSize;
+    madvise(mapping.first + start, it->second.offset + it->second.length - start, advice);
+}
@@ -0,0 +1,67 @@
+#ifndef __SEGMENTSTORE_H
+#define __SEGMENTSTORE_H
+
+#include "page.h"
+
+/**
+ * @brief The SegmentStore keeps the pages of a relation in segment files
+ * instead of one file per page. Each kind of page of a relation (table pages,
+ * hash buckets, matrix blocks) has its own segment, and a page lives in an
+ * extent of the segment, a run of fixed size slots (or a fraction of a slot,
+ * for small pages) read and written with a single pread or pwrite. The
+ * directory of extents is kept in memory only, as ../data/temp does not
+ * outlive the server.
+ *
+ * Deleting a page only returns its extent to the segment's free list, where it
+ * is reused by the next page written, and dropping a whole relation closes and
+ * unlinks one file. All calls are serialised, as the PageWriter writes pages
+ * from its own thread.
+ *
+ * Segments can also be mapped into memory, for read-mostly tables whose
+ * pages are then viewed in place instead of being copied into the pool.
+ *
+ */
+class SegmentStore {
+    struct Extent {
+        off_t offset;
+        size_t capacity;
+        size_t length;
+    };
+
+    struct Segment {
+        int fd = -1;
+        off_t end = 0;
+        unordered_map<PageId, Extent, PageIdHash> extents;
+        multimap<size_t, off_t> freeExtents;
+
+        // read-only mappings of the file, the last one the largest. Older
+        // mappings are kept until the segment is unmapped, as views into them
+        // may still be in use
+        vector<pair<char*, size_t>> mappings;
+    };
+
+    mutex lock;
+    unordered_map<PageId, Segment, PageIdHash> segments;
+
+    size_t slotSize();
+    size_t extentSize(size_t bytes);
+    Segment* getSegment(const PageId& id, bool create);
+    void release(Segment& segment, const Extent& extent);
+    void unmap(Segment& segment);
+
+   public:
+    ~SegmentStore();
+    size_t size(const PageId& id);
+    ssize_t read(const PageId& id, void* buffer, size_t bytes);
+    bool write(const PageId& id, const void* buffer, size_t bytes);
+    void erase(const PageId& id);
+    void drop(const PageId& segment);
+    void prefetch(const PageId& id);
+    const char* map(const PageId& id, size_t& length);
+    void unmap(const PageId& segment);
+    void advise(const PageId& id, int advice);
+};
+
+extern SegmentStore segmentStore;
+
+#endif
@@ -21,6 +21,7 @@ bool semanticParse(){
         case PROJECTION: return semanticParsePROJECTION();
         case RENAME: return semanticParseRENAME();
         case SELECTION: return semanticParseSELECTION();
+        case SET: return semanticParseSET();
         case SORT: return semanticParseSORT();
         case SOURCE: return semanticParseSOURCE();
         case TRANSPOSE: return semanticParseTRANSPOSE();
@@ -23,6 +23,7 @@ bool semanticParsePRINT();
 bool semanticParsePROJECTION();
 bool semanticParseRENAME();
 bool semanticParseSELECTION();
+bool semanticParseSET();
 bool semanticParseSORT();
 bool semanticParseSOURCE();
 bool semanticParseTRANSPOSE();
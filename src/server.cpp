@@ -6,9 +6,15 @@ using namespace std;
 float BLOCK_SIZE = 8;
 uint BLOCK_COUNT = 10;
 uint PRINT_COUNT = 20;
+uint THREAD_COUNT = 0; // workers of parallel scans, 0 for one per core
+#ifndef BUFFER_POLICY
+#define BUFFER_POLICY FIFO
+#endif
+ReplacementStrategy REPLACEMENT_STRATEGY = BUFFER_POLICY; // must precede bufferManager
 Logger logger;
 vector<string> tokenizedQuery;
 ParsedQuery parsedQuery;
+SegmentStore segmentStore; // must outlive bufferManager, whose writer writes pages on exit
 BufferManager bufferManager; // Required for deleting TableCatalogue and MatrixCatalogue objects
 TableCatalogue tableCatalogue;
 MatrixCatalogue matrixCatalogue;
@@ -37,9 +43,8 @@ int main(void)
         cout << "\n> ";
         tokenizedQuery.clear();
         parsedQuery.clear();
-        logger.log("\nReading New Command: ");
         getline(cin, command);
-        logger.log(command);
+        logger.info("\nReading New Command: ", command);
 
 
         auto words_begin = std::sregex_iterator(command.begin(), command.end(), delim);
@@ -49,6 +54,7 @@ int main(void)
 
         if (tokenizedQuery.size() == 1 && tokenizedQuery.front() == "QUIT")
         {
+            bufferManager.flushWrites();
             break;
         }
 
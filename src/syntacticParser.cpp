@@ -34,6 +34,8 @@ bool syntacticParse()
         return syntacticParseRENAME();
     else if (possibleQueryType == "EXPORT")
         return syntacticParseEXPORT();
+    else if (possibleQueryType == "SET")
+        return syntacticParseSET();
     else if (possibleQueryType == "SOURCE")
         return syntacticParseSOURCE();
     else if (possibleQueryType == "TRANSPOSE")
@@ -143,6 +145,10 @@ void ParsedQuery::clear()
     this->selectionSecondColumnName = "";
     this->selectionIntLiteral = 0;
 
+    this->setParameterName = "";
+    this->setParameterValue = "";
+    this->setRelationName = "";
+
     this->sortingStrategy = NO_SORT_CLAUSE;
     this->sortResultRelationName = "";
     this->sortColumnName = "";
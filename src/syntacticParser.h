@@ -32,6 +32,7 @@ enum QueryType
     PROJECTION,
     RENAME,
     SELECTION,
+    SET,
     SORT,
     SOURCE,
     TRANSPOSE,
@@ -133,6 +134,10 @@ public:
     string selectionSecondColumnName = "";
     int selectionIntLiteral = 0;
 
+    string setParameterName = "";
+    string setParameterValue = "";
+    string setRelationName = "";
+
     SortingStrategy sortingStrategy = NO_SORT_CLAUSE;
     string sortResultRelationName = "";
     string sortColumnName = "";
@@ -164,6 +169,7 @@ bool syntacticParsePRINT();
 bool syntacticParsePROJECTION();
 bool syntacticParseRENAME();
 bool syntacticParseSELECTION();
+bool syntacticParseSET();
 bool syntacticParseSORT();
 bool syntacticParseSOURCE();
 bool syntacticParseTRANSPOSE();
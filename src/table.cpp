@@ -174,7 +174,7 @@ bool Table::blockify() {
  *
  * @param row 
  */
-void Table::updateStatistics(vector<int> row) {
+void Table::updateStatistics(span<const int> row) {
     logger.log("Table::updateStatistics");
     this->rowCount++;
     for (int columnCounter = 0; columnCounter < this->columnCount; columnCounter++) {
@@ -248,29 +248,18 @@ void Table::print() {
     //print headings
     this->writeRow(this->columns, cout);
 
-    if (this->indexingStrategy == NOTHING) {
-        Cursor cursor(this->tableName, 0);
-        vector<int> row;
-        for (int rowCounter = 0; rowCounter < count; rowCounter++) {
-            row = cursor.getNext();
-            this->writeRow(row, cout);
-        }
-    } else if (this->indexingStrategy == HASH || this->indexingStrategy == BTREE) {
-        Cursor cursor = this->getCursor(0, 0);
-        vector<int> row;
-        for (int i = 0; i < count; i++) {
-            row = cursor.getNextInAllBuckets();
-            this->writeRow(row, cout);
-        }
-        // TODO: rewrite previous block like this
-    }
+    ScanIterator scan = this->getScan();
+    for (int rowCounter = 0; rowCounter < count; rowCounter++)
+        this->writeRow(scan.next(), cout);
 
     printRowCount(this->rowCount);
 }
 
 /**
- * @brief This function checks if cursor pageIndex is less than the table pageIndex, 
- * and calls the nextPage function of the cursor with incremented pageIndex.
+ * @brief This function finds the next page after the cursor's pageIndex, and
+ * before its endPage, that the cursor does not skip, and calls the nextPage
+ * function of the cursor with it. The cursor is left where it is if there is
+ * none.
  *
  * @param cursor 
  * @return vector<int> 
@@ -278,30 +267,36 @@ void Table::print() {
 void Table::getNextPage(Cursor *cursor) {
     logger.log("Table::getNextPage");
 
-    if (cursor->pageIndex < (int)this->blockCount - 1) {
-        cursor->nextPage(cursor->pageIndex + 1);
-    }
+    int endPage = min((int)this->blockCount, cursor->endPage);
+    for (int pageIndex = cursor->pageIndex + 1; pageIndex < endPage; pageIndex++)
+        if (!cursor->skips(PageId(cursor->relation, TABLE_PAGE, pageIndex))) {
+            cursor->nextPage(pageIndex);
+            return;
+        }
 }
 
 /**
- * @brief This function checks if cursor chainCount is less than the bucket chainCount, 
- * and calls the nextPage function of the cursor with incremented chainCount.
+ * @brief This function finds the next page of the cursor's bucket after its
+ * chainCount that the cursor does not skip, and calls the nextPage function
+ * of the cursor with it.
  *
  * @param cursor 
  * @return void 
  */
 void Table::getNextPage(Cursor *cursor, int chainCount) {
     logger.log("Table::getNextPage");
-    if (cursor->chainCount < this->blocksInBuckets[cursor->bucket].size() - 1) {
-        cursor->nextPage(cursor->bucket, cursor->chainCount + 1);
-    }
+    for (int chain = cursor->chainCount + 1; chain < (int)this->blocksInBuckets[cursor->bucket].size(); chain++)
+        if (!cursor->skips(PageId(cursor->relation, HASH_PAGE, cursor->bucket, chain))) {
+            cursor->nextPage(cursor->bucket, chain);
+            return;
+        }
 }
 
 /**
- * @brief This function checks if cursor chainCount is less than the bucket chainCount, 
- * and calls the nextPage function of the cursor with incremented chainCount. If the
- * bucket has been fully read, it calls the nextPage function of the cursor with
- * incremented bucketCount.
+ * @brief This function finds the next page of the cursor's bucket after its
+ * chainCount that the cursor does not skip, and calls the nextPage function
+ * of the cursor with it. Once the bucket has been fully read, it moves on to
+ * the pages of the following buckets.
  *
  * @param cursor 
  * @return void 
@@ -309,19 +304,13 @@ void Table::getNextPage(Cursor *cursor, int chainCount) {
 void Table::getNextPage(Cursor *cursor, int bucket, int chainCount) {
     logger.log("Table::getNextPage");
 
-    if (cursor->chainCount < this->blocksInBuckets[cursor->bucket].size() - 1)
-        cursor->nextPage(cursor->bucket, cursor->chainCount + 1);
-    else {
-        int bucket = -1;
-        for (int i = cursor->bucket + 1; i < this->blocksInBuckets.size(); i++)
-            if (this->blocksInBuckets[i].size()) {
-                bucket = i;
-                break;
+    int chain = cursor->chainCount + 1;
+    for (bucket = cursor->bucket; bucket < this->blocksInBuckets.size(); bucket++, chain = 0)
+        for (; chain < (int)this->blocksInBuckets[bucket].size(); chain++)
+            if (!cursor->skips(PageId(cursor->relation, HASH_PAGE, bucket, chain))) {
+                cursor->nextPage(bucket, chain);
+                return;
             }
-
-        if (bucket != -1)
-            cursor->nextPage(bucket, 0);
-    }
 }
 
 /**
@@ -338,21 +327,11 @@ void Table::makePermanent() {
 
     //print headings
     this->writeRow(this->columns, fout);
-    Cursor cursor;
-
-    if (!this->indexed)
-        cursor = this->getCursor();
-    else if (this->indexingStrategy == HASH || this->indexingStrategy == BTREE)
-        cursor = this->getCursor(0, 0);
-
-    vector<int> row;
-    for (long long rowCounter = 0; rowCounter < this->rowCount; rowCounter++) {
-        if (!this->indexed)
-            row = cursor.getNext();
-        else if (this->indexingStrategy == HASH || this->indexingStrategy == BTREE)
-            row = cursor.getNextInAllBuckets();
-        this->writeRow(row, fout);
-    }
+    ScanIterator scan = this->getScan();
+    RowBatch batch;
+    while (scan.nextBatch(batch))
+        for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++)
+            this->writeRow(batch[rowCounter], fout);
     fout.close();
 }
 
@@ -369,6 +348,42 @@ bool Table::isPermanent() {
     return false;
 }
 
+/**
+ * @brief Changes the layout the table pages are stored in, rearranging the
+ * pages already written. Rows keep their order.
+ *
+ * @param layout
+ */
+void Table::setLayout(PageLayout layout) {
+    logger.log("Table::setLayout");
+    if (layout == this->layout)
+        return;
+    if (!this->indexed)
+        for (int pageIndex = 0; pageIndex < this->blockCount; pageIndex++)
+            bufferManager.pinTablePage(this->tableName, pageIndex).mutate().setLayout(layout);
+    this->layout = layout;
+}
+
+/**
+ * @brief Turns compression of the pages of the table on or off, rewriting the
+ * pages already written.
+ *
+ * @param compressed
+ */
+void Table::setCompressed(bool compressed) {
+    logger.log("Table::setCompressed");
+    if (compressed == this->compressed)
+        return;
+    if (!this->indexed)
+        for (int pageIndex = 0; pageIndex < this->blockCount; pageIndex++)
+            bufferManager.pinTablePage(this->tableName, pageIndex).mutate().setCompressed(compressed);
+    else
+        for (int bucket = 0; bucket < this->blocksInBuckets.size(); bucket++)
+            for (int chainCount = 0; chainCount < this->blocksInBuckets[bucket].size(); chainCount++)
+                bufferManager.pinHashPage(this->tableName, bucket, chainCount).mutate().setCompressed(compressed);
+    this->compressed = compressed;
+}
+
 /**
  * @brief The unload function removes the table from the database by deleting
  * all temporary files created as part of this table
@@ -377,27 +392,25 @@ bool Table::isPermanent() {
 void Table::unload() {
     logger.log("Table::~unload");
     if (this->indexingStrategy == NOTHING) {
-        for (int pageCounter = 0; pageCounter < this->blockCount; pageCounter++)
-            bufferManager.deleteTableFile(this->tableName, pageCounter);
+        bufferManager.deleteSegment(this->tableName, TABLE_PAGE);
         if (!isPermanent())
             bufferManager.deleteFile(this->sourceFileName);
     } else if (this->indexingStrategy == HASH || this->indexingStrategy == BTREE) {
-        for (int i = 0; i < this->blocksInBuckets.size(); i++) {  // not necessarily this->M
-            for (int j = 0; j < this->blocksInBuckets[i].size(); j++) {
-                bufferManager.deleteHashFile(this->tableName, i, j);
-            }
-        }
+        bufferManager.deleteSegment(this->tableName, HASH_PAGE);
     }
+    bufferManager.forgetRelation(this->tableName);
 }
 
 /**
  * @brief Function that returns a cursor that reads rows from this table
  * 
+ * @param ring optional buffer ring for large scans
+ * @param filter optional filter of the pages to read
  * @return Cursor 
  */
-Cursor Table::getCursor() {
+Cursor Table::getCursor(BufferRing* ring, PageFilter filter) {
     logger.log("Table::getCursor");
-    Cursor cursor(this->tableName, 0);
+    Cursor cursor(this->tableName, 0, ring, filter);
     return cursor;
 }
 
@@ -405,14 +418,34 @@ Cursor Table::getCursor() {
  * @brief Function that returns a cursor that reads rows from the blocks of a bucket 
  * @param bucket
  * @param chainCount 
+ * @param ring optional buffer ring for large scans
+ * @param filter optional filter of the pages to read
+ * @param singleBucket whether only the chain of bucket is read, rather than
+ * every bucket from bucket on
  * @return Cursor 
  */
-Cursor Table::getCursor(int bucket, int chainCount) {
+Cursor Table::getCursor(int bucket, int chainCount, BufferRing* ring, PageFilter filter, bool singleBucket) {
     logger.log("Table::getCursor");
-    Cursor cursor(this->tableName, bucket, chainCount);
+    Cursor cursor(this->tableName, bucket, chainCount, ring, filter, singleBucket);
     return cursor;
 }
 
+/**
+ * @brief Function that returns a scan over every row of this table, through
+ * the access method that suits how the table is stored: its pages in order,
+ * or its bucket chains one after the other if it is indexed
+ * 
+ * @param ring optional buffer ring for large scans
+ * @param filter optional filter of the pages to read
+ * @return ScanIterator 
+ */
+ScanIterator Table::getScan(BufferRing* ring, PageFilter filter) {
+    logger.log("Table::getScan");
+    if (!this->indexed)
+        return HeapScan(this, ring, filter);
+    return BucketScan(this, ring, filter);
+}
+
 /**
  * @brief Function that returns the index of column indicated by columnName
  * 
@@ -427,6 +460,35 @@ int Table::getColumnIndex(string columnName) {
     }
 }
 
+/**
+ * @brief Buckets of the index that may hold the rows whose indexed column
+ * equals key: the bucket key hashes to, or for a B+ tree the buckets from
+ * the one the tree points to up to the last whose range starts at or before
+ * key, last one first
+ * 
+ * @param key
+ * 
+ * @return vector<int> empty if no bucket can hold key
+ */
+vector<int> Table::getBucketsOf(int key) {
+    logger.log("Table::getBucketsOf");
+    vector<int> buckets;
+    if (this->indexingStrategy == HASH)
+        buckets.push_back(this->hash(key));
+    else if (this->indexingStrategy == BTREE) {
+        auto record = this->bTree.find(key, nullptr);
+        if (record != nullptr) {
+            int firstBucket = record->val();
+            int endBucket = firstBucket;
+            while (endBucket < this->blocksInBuckets.size() && this->bucketRanges[endBucket].first <= key)
+                endBucket++;
+            for (int bucket = endBucket - 1; bucket >= firstBucket; bucket--)
+                buckets.push_back(bucket);
+        }
+    }
+    return buckets;
+}
+
 // LINEAR HASHING
 
 /**
@@ -473,19 +535,20 @@ void Table::linearHash(const string &columnName, int bucketCount) {
     int col = this->indexedColumn;
     Cursor cursor(this->tableName, 0);
 
-    vector<int> row;
-    for (long long i = 0; i < this->rowCount; i++) {
-        row = cursor.getNext();
-        int bucket = this->hash(row[col]);
-        this->insertIntoHashBucket(row, bucket);
-        // This would return if overflow or not,
-        // but we don't need to split right now.
-    }
+    // insertIntoHashBucket counts the new buckets in blockCount, so the
+    // table pages are read up to rowCount rows instead of up to blockCount
+    RowBatch batch;
+    for (long long rowsRead = 0; rowsRead < this->rowCount && cursor.nextBatch(batch); rowsRead += batch.rowCount)
+        for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++) {
+            span<const int> row = batch[rowCounter];
+            int bucket = this->hash(row[col]);
+            this->insertIntoHashBucket(row, bucket);
+            // This would return if overflow or not,
+            // but we don't need to split right now.
+        }
 
     // Delete existing pages
-    for (int i = 0; i < this->blockCount; i++) {
-        bufferManager.deleteTableFile(this->tableName, i);
-    }
+    bufferManager.deleteSegment(this->tableName, TABLE_PAGE);
 
     // Update block count
     this->blockCount = 0;
@@ -504,37 +567,28 @@ void Table::linearHash(const string &columnName, int bucketCount) {
  * @return bool indicating an overflow
  */
 
-bool Table::insertIntoHashBucket(const vector<int> &row, int bucket) {
+bool Table::insertIntoHashBucket(span<const int> row, int bucket) {
     logger.log("Table::insertIntoHashBucket");
     if (bucket >= this->blocksInBuckets.size()) {
         return false;  // TODO: raise an error somehow
     }
 
-    bool found = false;
-
-    vector<vector<int>> rows(0);
     int chainCount;
 
     for (chainCount = 0; chainCount < this->blocksInBuckets[bucket].size(); chainCount++) {
         if (blocksInBuckets[bucket][chainCount] < this->maxRowsPerBlock) {
-            rows = bufferManager.getHashPage(this->tableName, bucket, chainCount).data;
+            bufferManager.pinHashPage(this->tableName, bucket, chainCount).mutate().appendRow(row);
             this->blocksInBuckets[bucket][chainCount]++;
-
-            found = true;
-            break;
+            return false;
         }
     }
 
-    if (!found) {
-        this->blocksInBuckets[bucket].push_back(1);
-        this->blockCount++;
-        chainCount = blocksInBuckets[bucket].size() - 1;
-    }
-
-    rows.push_back(row);
-    bufferManager.writeHashPage(this->tableName, bucket, chainCount, rows);
+    this->blocksInBuckets[bucket].push_back(1);
+    this->blockCount++;
+    chainCount = blocksInBuckets[bucket].size() - 1;
+    bufferManager.writeHashPage(this->tableName, bucket, chainCount, {vector<int>(row.begin(), row.end())});
 
-    return !found;
+    return true;
 }
 
 /**
@@ -545,7 +599,7 @@ bool Table::insertIntoHashBucket(const vector<int> &row, int bucket) {
  * 
  * @return void
  */
-bool Table::insert(const vector<int> &row) {
+bool Table::insert(span<const int> row) {
     logger.log("Table::insert");
     if (row.size() != this->columnCount) {
         return false;
@@ -556,18 +610,15 @@ bool Table::insert(const vector<int> &row) {
         int blockIndex;
         for (blockIndex = 0; blockIndex < this->blockCount; blockIndex++) {
             if (this->rowsPerBlockCount[blockIndex] != this->maxRowsPerBlock) {
-                rows = bufferManager.getTablePage(this->tableName, blockIndex).data;
-                // rows.resize(this->rowsPerBlockCount[blockIndex]);
-                rows.push_back(row);
-                // bufferManager.deleteTableFile(this->tableName, blockIndex);
-                bufferManager.writeTablePage(this->tableName, blockIndex, rows, rows.size());
-                this->rowsPerBlockCount[blockIndex] = rows.size();
+                auto page = bufferManager.pinTablePage(this->tableName, blockIndex);
+                page.mutate().appendRow(row);
+                this->rowsPerBlockCount[blockIndex] = page->getRowCount();
                 break;
             }
         }
 
         if (blockIndex == this->blockCount) {
-            rows.push_back(row);
+            rows.emplace_back(row.begin(), row.end());
             bufferManager.writeTablePage(this->tableName, this->blockCount, rows, rows.size());
             this->blockCount++;
             this->rowsPerBlockCount.emplace_back(rows.size());
@@ -648,7 +699,7 @@ void Table::linearHashSplit() {
     this->blocksInBuckets.push_back(vector<int>(0));  // M + N + 1 (temporary)
 
     // rehash
-    Cursor cursor = this->getCursor(this->N, 0);
+    Cursor cursor = this->getCursor(this->N, 0, nullptr, nullptr, true);
     auto row = cursor.getNextInBucket();
     while (!row.empty()) {
         int hashkey = row[this->indexedColumn];
@@ -670,7 +721,7 @@ void Table::linearHashSplit() {
 
     // rename buckets
     for (int i = 0; i < this->blocksInBuckets.back().size(); i++) {
-        auto data = bufferManager.getHashPage(this->tableName, this->M + this->N + 1, i).data;
+        auto data = bufferManager.getHashPage(this->tableName, this->M + this->N + 1, i).getRows();
         bufferManager.deleteHashFile(this->tableName, this->M + this->N + 1, i);
 
         bufferManager.writeHashPage(this->tableName, this->N, i, data);
@@ -716,7 +767,7 @@ void Table::cleanupBlocks(int bucket) {
             continue;
         }
         // swap i and j
-        auto data = bufferManager.getHashPage(this->tableName, bucket, j).data;
+        auto data = bufferManager.getHashPage(this->tableName, bucket, j).getRows();
         bufferManager.deleteHashFile(this->tableName, bucket, j);
         bufferManager.writeHashPage(this->tableName, bucket, i, data);
         this->blocksInBuckets[bucket][i] = this->blocksInBuckets[bucket][j];
@@ -758,17 +809,17 @@ void Table::clearIndex() {
     this->rowsPerBlockCount.clear();
     this->rowCount = 0;
 
-    Cursor cursor = this->getCursor(0, 0);
-    vector<int> row = cursor.getNextInAllBuckets();
+    ScanIterator scan = this->getScan();
+    span<const int> row = scan.next();
     vector<vector<int>> rows;
 
     fill(this->smallestInColumns.begin(), this->smallestInColumns.end(), INT_MAX);
     fill(this->largestInColumns.begin(), this->largestInColumns.end(), INT_MIN);
 
     while (!row.empty()) {
-        rows.push_back(row);
+        rows.emplace_back(row.begin(), row.end());
         this->updateStatistics(row);
-        row = cursor.getNextInAllBuckets();
+        row = scan.next();
         if (rows.size() == this->maxRowsPerBlock) {
             this->rowsPerBlockCount.emplace_back(rows.size());
             bufferManager.writeTablePage(this->tableName, blocksWritten++, rows, rows.size());
@@ -782,9 +833,7 @@ void Table::clearIndex() {
         rows.clear();
     }
 
-    for (int bucket = 0; bucket < this->blocksInBuckets.size(); bucket++)
-        for (int chainCount = 0; chainCount < this->blocksInBuckets[bucket].size(); chainCount++)
-            bufferManager.deleteHashFile(this->tableName, bucket, chainCount);
+    bufferManager.deleteSegment(this->tableName, HASH_PAGE);
 
     this->blocksInBuckets.clear();
     if (this->indexingStrategy == HASH) {
@@ -832,10 +881,10 @@ void Table::mergeBlocks(int bucket) {
                     continue;
                 }
 
-                auto tail = bufferManager.getHashPage(this->tableName, bucket, j).data;
+                auto tail = bufferManager.getHashPage(this->tableName, bucket, j).getRows();
                 bufferManager.deleteHashFile(this->tableName, bucket, j);
 
-                auto head = bufferManager.getHashPage(this->tableName, bucket, i).data;
+                auto head = bufferManager.getHashPage(this->tableName, bucket, i).getRows();
                 head.insert(head.end(), tail.begin(), tail.end());
 
                 bufferManager.writeHashPage(this->tableName, bucket, i, head);
@@ -860,7 +909,7 @@ void Table::mergeBlocks(int bucket) {
  * 
  * @return bool true if the row was deleted
  */
-bool Table::remove(const vector<int> &row) {
+bool Table::remove(span<const int> row) {
     logger.log("Table::remove");
     // invalid row
     if (row.size() != this->columnCount) {
@@ -872,36 +921,27 @@ bool Table::remove(const vector<int> &row) {
             return false;
 
     long long foundCount = 0;
+    int relation = getRelationId(this->tableName);
 
     if (this->indexingStrategy == NOTHING) {
-        vector<vector<int>> data;
-        vector<vector<int>>::iterator it;
-        int pageIndex;
-
         for (int pageIndex = 0; pageIndex < this->blockCount; pageIndex++) {
-            long long foundInPage = 0;
-
-            data = bufferManager.getTablePage(this->tableName, pageIndex).data;
-            it = data.begin();
+            // pages whose zone map rules the row out are not read at all
+            const ZoneMap* zone = bufferManager.getZoneMap(PageId(relation, TABLE_PAGE, pageIndex));
+            if (zone && !zone->contains(row))
+                continue;
 
-            while (it != data.end()) {
-                if (*it == row) {
-                    it = data.erase(it);
-                    foundInPage++;
-                } else
-                    it++;
-            }
+            // only pages that hold the row are modified, and hence written back
+            auto page = bufferManager.pinTablePage(this->tableName, pageIndex);
+            if (!page->hasRow(row))
+                continue;
 
-            if (foundInPage > 0) {
-                this->rowsPerBlockCount[pageIndex] = data.size();
+            long long foundInPage = page.mutate().removeRow(row);
+            this->rowsPerBlockCount[pageIndex] = page->getRowCount();
 
-                if (data.size() == 0)
-                    bufferManager.deleteTableFile(this->tableName, pageIndex);
-                else
-                    bufferManager.writeTablePage(this->tableName, pageIndex, data, data.size());
+            if (page->getRowCount() == 0)
+                bufferManager.deleteTableFile(this->tableName, pageIndex);
 
-                foundCount = foundCount + foundInPage;
-            }
+            foundCount = foundCount + foundInPage;
         }
         if (foundCount) {
             bool foundAndFixed;
@@ -915,10 +955,10 @@ bool Table::remove(const vector<int> &row) {
                         if (this->rowsPerBlockCount[i] + this->rowsPerBlockCount[j] > this->maxRowsPerBlock || this->rowsPerBlockCount[j] == 0)
                             continue;
 
-                        auto tail = bufferManager.getTablePage(this->tableName, j).data;
+                        auto tail = bufferManager.getTablePage(this->tableName, j).getRows();
                         bufferManager.deleteTableFile(this->tableName, j);
 
-                        auto head = bufferManager.getTablePage(this->tableName, i).data;
+                        auto head = bufferManager.getTablePage(this->tableName, i).getRows();
                         head.insert(head.end(), tail.begin(), tail.end());
 
                         bufferManager.writeTablePage(this->tableName, i, head, head.size());
@@ -944,7 +984,7 @@ bool Table::remove(const vector<int> &row) {
             for (int i = 0; i < this->blockCount - 1; i++)  // remove 0 size blocks
             {
                 if (this->rowsPerBlockCount[i] == 0) {
-                    vector<vector<int>> finalBlockRows = bufferManager.getTablePage(this->tableName, this->blockCount - 1).data;
+                    vector<vector<int>> finalBlockRows = bufferManager.getTablePage(this->tableName, this->blockCount - 1).getRows();
                     bufferManager.deleteTableFile(this->tableName, this->blockCount - 1);
                     bufferManager.writeTablePage(this->tableName, i, finalBlockRows, finalBlockRows.size());
                     this->rowsPerBlockCount[i] = finalBlockRows.size();
@@ -960,36 +1000,22 @@ bool Table::remove(const vector<int> &row) {
         // does not use cursor because have to modify page if row was actually found
         int bucket = this->hash(row[this->indexedColumn]);
 
-        // to avoid repeated constructor and destructor calls
-        vector<vector<int>> data;
-        vector<vector<int>>::iterator it;
-
         for (int i = 0; i < this->blocksInBuckets[bucket].size(); i++) {
-            long long foundInPage = 0;
-
-            data = bufferManager.getHashPage(this->tableName, bucket, i).data;
-            it = data.begin();
+            const ZoneMap* zone = bufferManager.getZoneMap(PageId(relation, HASH_PAGE, bucket, i));
+            if (zone && !zone->contains(row))
+                continue;
 
-            while (it != data.end()) {
-                if (*it == row) {
-                    it = data.erase(it);
-                    foundInPage++;
-                } else {
-                    it++;
-                }
-            }
+            auto page = bufferManager.pinHashPage(this->tableName, bucket, i);
+            if (!page->hasRow(row))
+                continue;
 
-            if (foundInPage > 0) {
-                this->blocksInBuckets[bucket][i] = data.size();
+            long long foundInPage = page.mutate().removeRow(row);
+            this->blocksInBuckets[bucket][i] = page->getRowCount();
 
-                if (data.size() > 0) {
-                    bufferManager.writeHashPage(this->tableName, bucket, i, data);
-                } else {
-                    bufferManager.deleteHashFile(this->tableName, bucket, i);
-                }
+            if (page->getRowCount() == 0)
+                bufferManager.deleteHashFile(this->tableName, bucket, i);
 
-                foundCount = foundCount + foundInPage;
-            }
+            foundCount = foundCount + foundInPage;
         }
 
         if (foundCount > 0) {
@@ -1032,36 +1058,28 @@ bool Table::remove(const vector<int> &row) {
             bool anotherOneExists = false;     // same key different row exists
             bool somethingElseExists = false;  // the bucket is not empty after deletion
 
-            vector<vector<int>> data;
-            vector<vector<int>>::iterator it;
-            // to avoid repeated constructor and destructor calls
             for (int i = 0; i < this->blocksInBuckets[bucket].size(); i++) {
                 long long foundInPage = 0;
 
-                data = bufferManager.getHashPage(this->tableName, bucket, i).data;
-                it = data.begin();
-
-                while (it != data.end()) {
-                    if (*it == row) {
-                        it = data.erase(it);
+                auto page = bufferManager.pinHashPage(this->tableName, bucket, i);
+                for (int rowCounter = 0; rowCounter < page->getRowCount(); rowCounter++) {
+                    span<const int> pageRow = page->getRow(rowCounter);
+                    if (ranges::equal(pageRow, row)) {
                         foundInPage++;
                     } else {
-                        minn = min(minn, it->operator[](this->indexedColumn));
-                        maxx = max(maxx, it->operator[](this->indexedColumn));
-                        anotherOneExists |= (it->operator[](this->indexedColumn) == key);
+                        minn = min(minn, pageRow[this->indexedColumn]);
+                        maxx = max(maxx, pageRow[this->indexedColumn]);
+                        anotherOneExists |= (pageRow[this->indexedColumn] == key);
                         somethingElseExists = true;
-                        it++;
                     }
                 }
 
                 if (foundInPage > 0) {
-                    this->blocksInBuckets[bucket][i] = data.size();
+                    page.mutate().removeRow(row);
+                    this->blocksInBuckets[bucket][i] = page->getRowCount();
 
-                    if (data.size() > 0) {
-                        bufferManager.writeHashPage(this->tableName, bucket, i, data);
-                    } else {
+                    if (page->getRowCount() == 0)
                         bufferManager.deleteHashFile(this->tableName, bucket, i);
-                    }
 
                     foundInBucketCount = foundInBucketCount + foundInPage;
                 }
@@ -1132,7 +1150,7 @@ void Table::linearHashCombine() {
     int to = this->N - 1;
     int from = to + this->M;
 
-    Cursor cursor = this->getCursor(from, 0);
+    Cursor cursor = this->getCursor(from, 0, nullptr, nullptr, true);
     auto row = cursor.getNextInBucket();
     while (!row.empty()) {
         this->insertIntoHashBucket(row, to);
@@ -1170,8 +1188,10 @@ void Table::linearHashCombine() {
 void Table::sort(int bufferSize, string columnName, float capacity, int sortingStrategy) {
     logger.log("Table::sort");
     int runSize = this->maxRowsPerBlock * bufferSize;
-    Cursor cursor = this->getCursor();
-    vector<int> row = cursor.getNext();
+    ScanIterator scan = this->getScan();
+    RowBatch batch;
+    scan.nextBatch(batch);
+    int batchPointer = 0;
 
     int columnIndex = this->getColumnIndex(columnName);
     // TODO: change this to use columnindex directly
@@ -1188,12 +1208,17 @@ void Table::sort(int bufferSize, string columnName, float capacity, int sortingS
     this->rowsPerBlockCount.resize(newBlockCount + 2 * originalBlockCount);
 
     int blocksWritten = 0;
-    while (!row.empty()) {
+    while (batchPointer < batch.rowCount) {
         vector<vector<int>> rows;
+        rows.reserve(runSize);
         int rowsRead = 0;
-        while (!row.empty() && rowsRead != runSize) {
-            rows.push_back(row);
-            row = cursor.getNext();
+        while (batchPointer < batch.rowCount && rowsRead != runSize) {
+            span<const int> row = batch[batchPointer];
+            rows.emplace_back(row.begin(), row.end());
+            if (++batchPointer == batch.rowCount) {
+                scan.nextBatch(batch);
+                batchPointer = 0;
+            }
             rowsRead++;
         }
 
@@ -1239,32 +1264,33 @@ void Table::sort(int bufferSize, string columnName, float capacity, int sortingS
             unordered_map<int, int> pagesReadInRun;
             int minSize = min(runsCount - runsRead, bufferSize - 1);
 
-            vector<vector<vector<int>>> dataFromPages(minSize);
+            // the heap holds rows in place in the pages being merged
+            vector<TablePage> dataFromPages(minSize);
             vector<int> rowsReadFromPages(minSize, 0);
 
-            auto comp = [&](const pair<vector<int>, int> &a, const pair<vector<int>, int> &b) {
+            auto comp = [&](const pair<span<const int>, int> &a, const pair<span<const int>, int> &b) {
                 if (sortingStrategy == 0)
                     return a.first[columnIndex] > b.first[columnIndex];
                 else if (sortingStrategy == 1)
                     return a.first[columnIndex] < b.first[columnIndex];
             };
 
-            priority_queue<pair<vector<int>, int>, vector<pair<vector<int>, int>>, function<bool(const pair<vector<int>, int> &a, const pair<vector<int>, int> &b)>> heap(comp);
+            priority_queue<pair<span<const int>, int>, vector<pair<span<const int>, int>>, function<bool(const pair<span<const int>, int> &a, const pair<span<const int>, int> &b)>> heap(comp);
 
             for (int i = 0; i < minSize; i++) {
                 int runPageIndex = (passCount & 1 ? newBlockCount + originalBlockCount : newBlockCount);
 
                 runPageIndex += ((runsRead + i) * pagesInRun[passCount * zerothPassRunsCount] + pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + i)]++);
-                dataFromPages[i] = (bufferManager.getTablePage(this->tableName, runPageIndex).data);
+                dataFromPages[i] = bufferManager.getTablePage(this->tableName, runPageIndex);
                 // dataFromPages[i].resize(this->rowsPerBlockCount[runPageIndex]);
-                heap.push(make_pair(dataFromPages[i][rowsReadFromPages[i]++], i));
+                heap.push(make_pair(dataFromPages[i].getRow(rowsReadFromPages[i]++), i));
             }
             vector<vector<int>> rows;
             while (!heap.empty()) {
-                pair<vector<int>, int> temp = heap.top();
+                pair<span<const int>, int> temp = heap.top();
                 heap.pop();
 
-                rows.push_back(temp.first);
+                rows.emplace_back(temp.first.begin(), temp.first.end());
                 if (rows.size() == newMaxRowsPerBlock && passCount == totalPasses - 1) {
                     this->blocksInBuckets[finalBlocksWritten].emplace_back(rows.size());
                     bufferManager.writeHashPage(this->tableName, finalBlocksWritten++, 0, rows);
@@ -1290,17 +1316,17 @@ void Table::sort(int bufferSize, string columnName, float capacity, int sortingS
 
                 runPageIndex += ((runsRead + temp.second) * pagesInRun[passCount * zerothPassRunsCount] + pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)] - 1);
                 if (rowsReadFromPages[temp.second] != this->rowsPerBlockCount[runPageIndex])
-                    heap.push(make_pair(dataFromPages[temp.second][rowsReadFromPages[temp.second]++], temp.second));
+                    heap.push(make_pair(dataFromPages[temp.second].getRow(rowsReadFromPages[temp.second]++), temp.second));
                 else  //all rows exhausted
                 {
                     if (pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)] != pagesInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)])  // all pages not exhausted
                     {
                         int runPageIndex = (passCount & 1 ? newBlockCount + originalBlockCount : newBlockCount);
                         runPageIndex += ((runsRead + temp.second) * pagesInRun[passCount * zerothPassRunsCount] + pagesReadInRun[passCount * zerothPassRunsCount + (runsRead + temp.second)]++);
-                        dataFromPages[temp.second] = bufferManager.getTablePage(this->tableName, runPageIndex).data;
+                        dataFromPages[temp.second] = bufferManager.getTablePage(this->tableName, runPageIndex);
                         // dataFromPages[temp.second].resize(this->rowsPerBlockCount[runPageIndex]);
                         rowsReadFromPages[temp.second] = 0;
-                        heap.push(make_pair(dataFromPages[temp.second][rowsReadFromPages[temp.second]++], temp.second));
+                        heap.push(make_pair(dataFromPages[temp.second].getRow(rowsReadFromPages[temp.second]++), temp.second));
                     }
                 }
             }
@@ -1335,7 +1361,7 @@ void Table::sort(int bufferSize, string columnName, float capacity, int sortingS
         vector<vector<int>> rowsToWrite;
         vector<vector<int>> pageData;
         for (int i = newBlockCount; i < this->blockCount; i++) {
-            pageData = bufferManager.getTablePage(this->tableName, i).data;
+            pageData = bufferManager.getTablePage(this->tableName, i).getRows();
 
             int rowsWritten = 0;
 
@@ -1414,19 +1440,18 @@ void Table::bTreeIndex(const string &columnName, int fanout) {
     fill(this->bucketRanges.begin(), this->bucketRanges.end(), make_pair(INT_MAX, INT_MIN));
 
     Cursor cursor;  // avoid constructor destructor calls
-    vector<int> row;
+    RowBatch batch;
     for (int bucket = this->blocksInBuckets.size() - 1; bucket >= 0; bucket--) {
-        cursor = this->getCursor(bucket, 0);
-        row = cursor.getNextInBucket();
-        while (!row.empty()) {
-            this->bucketRanges[bucket].first = min(this->bucketRanges[bucket].first, row[colIndex]);
-            this->bucketRanges[bucket].second = max(this->bucketRanges[bucket].second, row[colIndex]);
-
-            // subsequent buckets will overwrite this, that's why going in reverse order of buckets
-            this->bTree.insert(row[colIndex], bucket);
-
-            row = cursor.getNextInBucket();
-        }
+        cursor = this->getCursor(bucket, 0, nullptr, nullptr, true);
+        while (cursor.nextBatchInBucket(batch))
+            for (int rowCounter = 0; rowCounter < batch.rowCount; rowCounter++) {
+                int key = batch[rowCounter][colIndex];
+                this->bucketRanges[bucket].first = min(this->bucketRanges[bucket].first, key);
+                this->bucketRanges[bucket].second = max(this->bucketRanges[bucket].second, key);
+
+                // subsequent buckets will overwrite this, that's why going in reverse order of buckets
+                this->bTree.insert(key, bucket);
+            }
     }
 
     this->indexed = true;
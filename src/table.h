@@ -1,7 +1,7 @@
 #ifndef __TABLE_H
 #define __TABLE_H
 
-#include "cursor.h"
+#include "scanIterator.h"
 
 enum IndexingStrategy {
     BTREE,
@@ -45,10 +45,14 @@ class Table {
     bool indexed = false;
     int indexedColumn = -1;
     IndexingStrategy indexingStrategy = NOTHING;
+    // layout of the table pages, hash buckets are always stored row after row
+    PageLayout layout = ROW_LAYOUT;
+    // pages are compressed on disk, see writePageData
+    bool compressed = false;
 
     bool extractColumnNames(string firstLine);
     bool blockify();
-    void updateStatistics(vector<int> row);
+    void updateStatistics(span<const int> row);
     Table();
     Table(string tableName);
     Table(string tableName, vector<string> columns);
@@ -62,14 +66,17 @@ class Table {
     void getNextPage(Cursor *cursor, int chainCount);
     void getNextPage(Cursor *cursor, int bucket, int chainCount);
 
-    Cursor getCursor();
-    Cursor getCursor(int bucket, int chainCount);
+    Cursor getCursor(BufferRing* ring = nullptr, PageFilter filter = nullptr);
+    Cursor getCursor(int bucket, int chainCount, BufferRing* ring = nullptr, PageFilter filter = nullptr, bool singleBucket = false);
+    ScanIterator getScan(BufferRing* ring = nullptr, PageFilter filter = nullptr);
     int getColumnIndex(string columnName);
     string getIndexedColumn();
     void unload();
+    void setLayout(PageLayout layout);
+    void setCompressed(bool compressed);
     void sort(int bufferSize, string columnName, float capacity, int sortingStrategy);
-    bool insert(const vector<int>& row);
-    bool remove(const vector<int>& row);
+    bool insert(span<const int> row);
+    bool remove(span<const int> row);
     
     
     // FOR INDEXING
@@ -77,6 +84,7 @@ class Table {
     vector<vector<int>> blocksInBuckets;
     float density(int offsetRows = 0, int offsetBlocks = 0);
     void clearIndex();
+    vector<int> getBucketsOf(int key);
 
     // FOR LINEAR HASHING
 
@@ -88,7 +96,7 @@ class Table {
     
     int hash(int key);
     void linearHash(const string &columnName, int bucketCount);
-    bool insertIntoHashBucket(const vector<int>& row, int bucket);
+    bool insertIntoHashBucket(span<const int> row, int bucket);
     void linearHashSplit();
     void linearHashCombine();
     void cleanupBlocks(int bucket);
@@ -106,11 +114,12 @@ class Table {
  * @brief Static function that takes a vector of valued and prints them out in a
  * comma seperated format.
  *
- * @tparam T current usaages include int and string
+ * @tparam Row current usaages include vectors of int and string, and spans
+ * of int
  * @param row 
  */
-    template <typename T>
-    void writeRow(vector<T> row, ostream &fout) {
+    template <typename Row>
+    void writeRow(const Row& row, ostream &fout) {
         logger.log("Table::printRow");
         for (int columnCounter = 0; columnCounter < row.size(); columnCounter++) {
             if (columnCounter != 0)
@@ -124,11 +133,12 @@ class Table {
  * @brief Static function that takes a vector of valued and prints them out in a
  * comma seperated format.
  *
- * @tparam T current usaages include int and string
+ * @tparam Row current usaages include vectors of int and string, and spans
+ * of int
  * @param row 
  */
-    template <typename T>
-    void writeRow(vector<T> row) {
+    template <typename Row>
+    void writeRow(const Row& row) {
         logger.log("Table::printRow");
         ofstream fout(this->sourceFileName, ios::app);
         this->writeRow(row, fout);
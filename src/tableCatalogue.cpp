@@ -4,6 +4,7 @@ void TableCatalogue::insertTable(Table* table)
 {
     logger.log("TableCatalogue::insertTable"); 
     this->tables[table->tableName] = table;
+    this->bindRelation(table->tableName, table);
 }
 void TableCatalogue::deleteTable(string tableName)
 {
@@ -11,6 +12,7 @@ void TableCatalogue::deleteTable(string tableName)
     this->tables[tableName]->unload();
     delete this->tables[tableName];
     this->tables.erase(tableName);
+    this->bindRelation(tableName, nullptr);
 }
 /**
  * @brief Replaces tablename in the catalogue
@@ -26,6 +28,8 @@ void TableCatalogue::replaceTableName(string oldTableName, string newTableName)
     logger.log("TableCatalogue::replaceTableName"); 
     this->tables[newTableName] = this->tables[oldTableName];
     this->tables.erase(oldTableName);
+    this->bindRelation(newTableName, this->tables[newTableName]);
+    this->bindRelation(oldTableName, nullptr);
 }
 Table* TableCatalogue::getTable(string tableName)
 {
@@ -33,6 +37,34 @@ Table* TableCatalogue::getTable(string tableName)
     Table *table = this->tables[tableName];
     return table;
 }
+/**
+ * @brief Looks the table up by the relation id of its name. Used on the hot
+ * path of cursors and pages, so it neither logs nor hashes the name.
+ *
+ * @param relation 
+ * @return Table* nullptr if there is no such table
+ */
+Table* TableCatalogue::getTable(int relation)
+{
+    if (relation < 0 || relation >= (int)this->tablesByRelation.size())
+        return nullptr;
+    return this->tablesByRelation[relation];
+}
+
+/**
+ * @brief Points the relation id of tableName at table
+ *
+ * @param tableName 
+ * @param table nullptr once the table is gone
+ */
+void TableCatalogue::bindRelation(const string& tableName, Table* table)
+{
+    int relation = getRelationId(tableName);
+    if (relation >= (int)this->tablesByRelation.size())
+        this->tablesByRelation.resize(relation + 1, nullptr);
+    this->tablesByRelation[relation] = table;
+}
+
 bool TableCatalogue::isTable(string tableName)
 {
     logger.log("TableCatalogue::isTable"); 
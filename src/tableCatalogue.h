@@ -1,18 +1,23 @@
 #ifndef __TABLECATALOGUE_H
 #define __TABLECATALOGUE_H
 
-#include "table.h"
+#include "parallelScan.h"
 
 /**
  * @brief The TableCatalogue acts like an index of tables existing in the
  * system. Everytime a table is added(removed) to(from) the system, it needs to
- * be added(removed) to(from) the tableCatalogue. 
+ * be added(removed) to(from) the tableCatalogue. Tables can also be looked up
+ * by the relation id of their name, without hashing it.
  *
  */
 class TableCatalogue
 {
 
     unordered_map<string, Table*> tables;
+    // the same tables indexed by the relation id of their name (see
+    // getRelationId), for cursors and pages that look their table up per page
+    vector<Table*> tablesByRelation;
+    void bindRelation(const string& tableName, Table* table);
 
 public:
     TableCatalogue() {}
@@ -20,6 +25,7 @@ public:
     void deleteTable(string tableName);
     void replaceTableName(string oldTableName, string newTableName);
     Table* getTable(string tableName);
+    Table* getTable(int relation);
     bool isTable(string tableName);
     bool isColumnFromTable(string columnName, string tableName);
     void print();